@@ -0,0 +1,487 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "create.h"
+#include "math.h"
+#include "csr.h"
+#include "bsr.h"
+#include "hibrida.h"
+#include "elementwise.h"
+#include "semiring.h"
+#include "reorder.h"
+#include "spmv.h"
+#include "spmm.h"
+#include "parallel.h"
+#include "generators.h"
+#include "simd.h"
+#include "timer.h"
+#include "instrument.h"
+
+/*
+ * Benchmark das operações da matriz esparsa.
+ *
+ * Uso: benchmark [--gerador=uniform|banded|powerlaw|blockdiag|todos] [--n=N]
+ *                [--densidade=D] [--banda=B] [--grau-max=G] [--bloco=T]
+ *                [--densidade-bloco=DB]
+ *                [--reps=R] [--threads=P] [--semente=S] [--spmm-k=K]
+ *
+ * Cada medição é impressa como uma linha JSON (JSON Lines) na saída padrão.
+ */
+
+typedef struct Config {
+    const char *gerador;
+    int n;
+    double densidade;
+    int banda;
+    int grau_max;
+    int tam_bloco;
+    double densidade_bloco;
+    int reps;
+    int threads;
+    unsigned semente;
+    int spmm_k;
+} Config;
+
+/*
+ * Pico de memória residente desde o último `zera_pico_rss`. No Linux, vem de
+ * VmHWM em /proc/self/status, que `zera_pico_rss` reinicia; sem isso, cai no
+ * ru_maxrss, que é o pico do processo inteiro e só cresce.
+ */
+static long pico_rss_kb(void) {
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/status", "r");
+    if (f) {
+        char linha[128];
+        long kb = -1;
+        while (fgets(linha, sizeof linha, f)) {
+            if (sscanf(linha, "VmHWM: %ld kB", &kb) == 1) break;
+        }
+        fclose(f);
+        if (kb >= 0) return kb;
+    }
+#endif
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return -1;
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;
+#else
+    return ru.ru_maxrss;
+#endif
+}
+
+/* Reinicia o pico (VmHWM) para o uso atual, de modo que cada operação meça só o seu. */
+static void zera_pico_rss(void) {
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+#endif
+}
+
+static long long conta_nnz(const Matrix *m) {
+    long long nnz = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) nnz++;
+    }
+    return nnz;
+}
+
+/* Número de produtos parciais de m * n. */
+static long long conta_produtos(const Matrix *m, const Matrix *n) {
+    long long total = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            for (POINT q = n->mat[p->coluna - 1]; q; q = q->prox) total++;
+        }
+    }
+    return total;
+}
+
+static void relata(const Config *c, const char *gerador, const char *op, long long nnz,
+                   long long ns_total, int reps, double flops, const NoPool *pool) {
+    double ns_op = (double)ns_total / reps;
+
+    /* operações sem pool de nós (CSR, BSR, vetores densos) relatam null */
+    char nos[24] = "null", slabs[16] = "null";
+    if (pool) {
+        snprintf(nos, sizeof nos, "%lld", pool->alocados);
+        snprintf(slabs, sizeof slabs, "%d", pool->nslabs);
+    }
+
+    printf("{\"gerador\":\"%s\",\"n\":%d,\"nnz\":%lld,\"op\":\"%s\",\"reps\":%d,"
+           "\"threads\":%d,\"simd\":\"%s\",\"ns_por_op\":%.0f,\"ns_por_nnz\":%.3f,"
+           "\"gflops\":%.4f,\"nos_alocados\":%s,\"slabs\":%s,\"pico_rss_kb\":%ld}\n",
+           gerador, c->n, nnz, op, reps, c->threads, simd_nome(simd_nivel()), ns_op,
+           nnz ? ns_op / (double)nnz : 0.0, ns_op > 0 ? flops / ns_op : 0.0,
+           nos, slabs, pico_rss_kb());
+    fflush(stdout);
+    zera_pico_rss();
+}
+
+/* Tempo de cada thread na última execução do SpMV paralelo, para verificar o balanço. */
+static void relata_threads(const char *gerador, const PlanoSpmv *p) {
+    printf("{\"gerador\":\"%s\",\"op\":\"spmv_csr_parallel_threads\",\"ns_thread\":[", gerador);
+    for (int t = 0; t < p->nthreads; t++) printf("%s%lld", t ? "," : "", p->ns_thread[t]);
+    printf("]}\n");
+    fflush(stdout);
+}
+
+static void relata_ordem(const char *gerador, const RelatorioOrdem *r) {
+    printf("{\"gerador\":\"%s\",\"op\":\"reorder_rcm_banda\",\"banda_antes\":%d,\"banda_depois\":%d,"
+           "\"perfil_antes\":%lld,\"perfil_depois\":%lld}\n",
+           gerador, r->banda_antes, r->banda_depois, r->perfil_antes, r->perfil_depois);
+    fflush(stdout);
+}
+
+static int gera(const Config *c, const char *gerador, unsigned semente, Matrix **r) {
+    if (!strcmp(gerador, "uniform")) return generate_uniform(c->n, c->n, c->densidade, semente, r);
+    if (!strcmp(gerador, "banded")) return generate_banded(c->n, c->banda, semente, r);
+    if (!strcmp(gerador, "powerlaw")) return generate_powerlaw(c->n, c->n, c->grau_max, semente, r);
+    if (!strcmp(gerador, "blockdiag")) {
+        return generate_block_diagonal(c->n / c->tam_bloco, c->tam_bloco, c->densidade_bloco, semente, r);
+    }
+    return 1;
+}
+
+/* Reconstrói A por chamadas individuais de matrix_setelem, em ordem aleatória. */
+static int bench_setelem(const Config *c, const char *gerador, const Matrix *a, long long nnz) {
+    int *is = (int*)malloc((size_t)(nnz ? nnz : 1) * sizeof(int));
+    int *js = (int*)malloc((size_t)(nnz ? nnz : 1) * sizeof(int));
+    float *vs = (float*)malloc((size_t)(nnz ? nnz : 1) * sizeof(float));
+    if (!is || !js || !vs) {
+        free(is);
+        free(js);
+        free(vs);
+        return 1;
+    }
+
+    long long k = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        for (POINT p = a->mat[i]; p; p = p->prox, k++) {
+            is[k] = i + 1;
+            js[k] = p->coluna;
+            vs[k] = p->valor;
+        }
+    }
+    unsigned long long s = c->semente * 2654435761ULL + 1;
+    for (long long t = nnz - 1; t > 0; t--) {
+        s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+        long long u = (long long)((s >> 33) % (unsigned long long)(t + 1));
+        int ti = is[t], tj = js[t];
+        float tv = vs[t];
+        is[t] = is[u]; js[t] = js[u]; vs[t] = vs[u];
+        is[u] = ti; js[u] = tj; vs[u] = tv;
+    }
+
+    long long total = 0;
+    for (int rep = 0; rep < c->reps; rep++) {
+        Matrix *b = init_matrix(a->linhas, a->colunas);
+        if (!b) break;
+
+        long long t0 = timer_ns();
+        for (long long t = 0; t < nnz; t++) matrix_setelem(b, is[t], js[t], vs[t]);
+        total += timer_ns() - t0;
+
+        if (rep == c->reps - 1) relata(c, gerador, "setelem", nnz, total, c->reps, 0.0, &b->pool);
+        matrix_destroy(b);
+    }
+
+    free(is);
+    free(js);
+    free(vs);
+    return 0;
+}
+
+static int bench_gerador(const Config *c, const char *gerador) {
+    Matrix *a = NULL, *b = NULL, *r = NULL;
+
+    if (gera(c, gerador, c->semente, &a) || gera(c, gerador, c->semente + 1, &b)) {
+        fprintf(stderr, "Erro ao gerar matriz '%s'.\n", gerador);
+        matrix_destroy(a);
+        return 1;
+    }
+
+    long long nnz_a = conta_nnz(a);
+    long long nnz_b = conta_nnz(b);
+    long long produtos = conta_produtos(a, b);
+    long long t0, total;
+    zera_pico_rss();
+
+    bench_setelem(c, gerador, a, nnz_a);
+
+    total = 0;
+    for (int rep = 0; rep < c->reps; rep++) {
+        t0 = timer_ns();
+        matrix_add(a, b, &r);
+        total += timer_ns() - t0;
+        if (rep == c->reps - 1) relata(c, gerador, "add", nnz_a + nnz_b, total, c->reps, (double)(nnz_a + nnz_b), r ? &r->pool : NULL);
+        matrix_destroy(r);
+    }
+
+    /*
+     * acumulação em fluxo: b somada repetidamente na mesma matriz. Os contadores
+     * do pool são acumulados desde a cópia inicial, então relata os nós
+     * alocados/liberados pela última soma, e não os totais do pool.
+     */
+    Matrix *vazia = init_matrix(a->linhas, a->colunas);
+    if (vazia && matrix_add(a, vazia, &r) == 0) {
+        NoPool passo = r->pool;
+        total = 0;
+        for (int rep = 0; rep < c->reps; rep++) {
+            long long alocados0 = r->pool.alocados, liberados0 = r->pool.liberados;
+            t0 = timer_ns();
+            matrix_add_inplace(r, b);
+            total += timer_ns() - t0;
+            passo = r->pool;
+            passo.alocados -= alocados0;
+            passo.liberados -= liberados0;
+        }
+        relata(c, gerador, "add_inplace", nnz_a + nnz_b, total, c->reps, (double)nnz_b, &passo);
+        matrix_destroy(r);
+    }
+    matrix_destroy(vazia);
+
+    total = 0;
+    for (int rep = 0; rep < c->reps; rep++) {
+        t0 = timer_ns();
+        matrix_hadamard(a, b, &r);
+        total += timer_ns() - t0;
+        if (rep == c->reps - 1) relata(c, gerador, "hadamard", nnz_a + nnz_b, total, c->reps, 0.0, r ? &r->pool : NULL);
+        matrix_destroy(r);
+    }
+
+    total = 0;
+    for (int rep = 0; rep < c->reps; rep++) {
+        t0 = timer_ns();
+        matrix_multiply(a, b, &r);
+        total += timer_ns() - t0;
+        if (rep == c->reps - 1) relata(c, gerador, "multiply", nnz_a + nnz_b, total, c->reps, 2.0 * (double)produtos, r ? &r->pool : NULL);
+        matrix_destroy(r);
+    }
+
+    total = 0;
+    for (int rep = 0; rep < c->reps; rep++) {
+        t0 = timer_ns();
+        matrix_multiply_parallel(a, b, &r, c->threads);
+        total += timer_ns() - t0;
+        if (rep == c->reps - 1) relata(c, gerador, "multiply_parallel", nnz_a + nnz_b, total, c->reps, 2.0 * (double)produtos, r ? &r->pool : NULL);
+        matrix_destroy(r);
+    }
+
+    total = 0;
+    for (int rep = 0; rep < c->reps; rep++) {
+        t0 = timer_ns();
+        matrix_transpose(a, &r);
+        total += timer_ns() - t0;
+        if (rep == c->reps - 1) relata(c, gerador, "transpose", nnz_a, total, c->reps, 0.0, r ? &r->pool : NULL);
+        matrix_destroy(r);
+    }
+
+    MatrixHibrida *ha = NULL, *hb = NULL, *hr = NULL;
+    if (hibrida_from_matrix(a, &ha) == 0 && hibrida_from_matrix(b, &hb) == 0) {
+        total = 0;
+        for (int rep = 0; rep < c->reps; rep++) {
+            t0 = timer_ns();
+            hibrida_add(ha, hb, &hr);
+            total += timer_ns() - t0;
+            hibrida_destroy(hr);
+        }
+        relata(c, gerador, "add_hibrida", nnz_a + nnz_b, total, c->reps, (double)(nnz_a + nnz_b), NULL);
+
+        total = 0;
+        for (int rep = 0; rep < c->reps; rep++) {
+            t0 = timer_ns();
+            hibrida_multiply(ha, hb, &hr);
+            total += timer_ns() - t0;
+            hibrida_destroy(hr);
+        }
+        relata(c, gerador, "multiply_hibrida", nnz_a + nnz_b, total, c->reps, 2.0 * (double)produtos, NULL);
+    }
+    hibrida_destroy(ha);
+    hibrida_destroy(hb);
+
+    MatrixCSR *ca = NULL;
+    float *x = (float*)malloc((size_t)c->n * sizeof(float));
+    float *y = (float*)malloc((size_t)c->n * sizeof(float));
+    if (x && y && csr_from_matrix(a, &ca) == 0) {
+        for (int j = 0; j < c->n; j++) x[j] = 1.0f / (float)(j + 1);
+        int reps = c->reps * 10;
+
+        t0 = timer_ns();
+        for (int rep = 0; rep < reps; rep++) matrix_spmv(a, x, y);
+        relata(c, gerador, "spmv_lista", nnz_a, timer_ns() - t0, reps, 2.0 * (double)nnz_a, NULL);
+
+        t0 = timer_ns();
+        for (int rep = 0; rep < reps; rep++) csr_spmv(ca, x, y);
+        relata(c, gerador, "spmv_csr", nnz_a, timer_ns() - t0, reps, 2.0 * (double)nnz_a, NULL);
+
+        /* o mesmo produto com cada nível de SIMD forçado: nenhum deve perder para o escalar */
+        SimdNivel nivel_original = simd_nivel();
+        for (int nivel = SIMD_ESCALAR; nivel <= SIMD_AVX512; nivel++) {
+            if (simd_set_nivel((SimdNivel)nivel) != (SimdNivel)nivel) continue;
+            t0 = timer_ns();
+            for (int rep = 0; rep < reps; rep++) csr_spmv(ca, x, y);
+            relata(c, gerador, "spmv_csr_nivel", nnz_a, timer_ns() - t0, reps, 2.0 * (double)nnz_a, NULL);
+        }
+        simd_set_nivel(nivel_original);
+
+        t0 = timer_ns();
+        for (int rep = 0; rep < reps; rep++) csr_mxv_min_plus(ca, x, NULL, 0, y);
+        relata(c, gerador, "mxv_min_plus", nnz_a, timer_ns() - t0, reps, 2.0 * (double)nnz_a, NULL);
+
+        /* produto CSR usual e sobre o semianel min-plus */
+        MatrixCSR *cb = NULL, *cc = NULL;
+        if (csr_from_matrix(b, &cb) == 0) {
+            total = 0;
+            for (int rep = 0; rep < c->reps; rep++) {
+                t0 = timer_ns();
+                csr_multiply(ca, cb, &cc);
+                total += timer_ns() - t0;
+                csr_destroy(cc);
+            }
+            relata(c, gerador, "multiply_csr", nnz_a + nnz_b, total, c->reps, 2.0 * (double)produtos, NULL);
+
+            total = 0;
+            for (int rep = 0; rep < c->reps; rep++) {
+                t0 = timer_ns();
+                csr_mxm_min_plus(ca, cb, NULL, 0, &cc);
+                total += timer_ns() - t0;
+                csr_destroy(cc);
+            }
+            relata(c, gerador, "mxm_min_plus", nnz_a + nnz_b, total, c->reps, 2.0 * (double)produtos, NULL);
+        }
+        csr_destroy(cb);
+
+        /* SpMM com B densa de n x spmm_k */
+        int k = c->spmm_k;
+        float *bd = (float*)malloc((size_t)c->n * k * sizeof(float));
+        float *cd = (float*)malloc((size_t)c->n * k * sizeof(float));
+        if (bd && cd) {
+            for (size_t t = 0; t < (size_t)c->n * k; t++) bd[t] = 1.0f / (float)(t % 97 + 1);
+            double flops = 2.0 * (double)nnz_a * k;
+
+            t0 = timer_ns();
+            for (int rep = 0; rep < c->reps; rep++) matrix_spmm(a, bd, k, k, cd, k);
+            relata(c, gerador, "spmm_lista", nnz_a, timer_ns() - t0, c->reps, flops, NULL);
+
+            t0 = timer_ns();
+            for (int rep = 0; rep < c->reps; rep++) csr_spmm(ca, bd, k, k, cd, k);
+            relata(c, gerador, "spmm_csr", nnz_a, timer_ns() - t0, c->reps, flops, NULL);
+
+            t0 = timer_ns();
+            for (int rep = 0; rep < c->reps; rep++) csr_spmm_parallel(ca, bd, k, k, cd, k, c->threads);
+            relata(c, gerador, "spmm_csr_parallel", nnz_a, timer_ns() - t0, c->reps, flops, NULL);
+        }
+        free(bd);
+        free(cd);
+
+        MatrixBSR *ba = NULL;
+        if (bsr_from_matrix(a, &ba) == 0) {
+            t0 = timer_ns();
+            for (int rep = 0; rep < reps; rep++) bsr_spmv(ba, x, y);
+            relata(c, gerador, "spmv_bsr", nnz_a, timer_ns() - t0, reps, 2.0 * (double)nnz_a, NULL);
+        }
+        bsr_destroy(ba);
+
+        PlanoSpmv *plano = NULL;
+        if (plano_spmv_init(ca, c->threads, &plano) == 0) {
+            t0 = timer_ns();
+            for (int rep = 0; rep < reps; rep++) csr_spmv_parallel(plano, x, y);
+            relata(c, gerador, "spmv_csr_parallel", nnz_a, timer_ns() - t0, reps, 2.0 * (double)nnz_a, NULL);
+            relata_threads(gerador, plano);
+        }
+        plano_spmv_destroy(plano);
+
+        int *perm = (int*)malloc((size_t)c->n * sizeof(int));
+        Matrix *ra = NULL;
+        MatrixCSR *cr = NULL;
+        RelatorioOrdem rel;
+        t0 = timer_ns();
+        if (perm && matrix_reorder(a, ORDEM_RCM, perm, &ra, &rel) == 0) {
+            relata(c, gerador, "reorder_rcm", nnz_a, timer_ns() - t0, 1, 0.0, &ra->pool);
+            relata_ordem(gerador, &rel);
+            if (csr_from_matrix(ra, &cr) == 0) {
+                t0 = timer_ns();
+                for (int rep = 0; rep < reps; rep++) csr_spmv(cr, x, y);
+                relata(c, gerador, "spmv_csr_rcm", nnz_a, timer_ns() - t0, reps, 2.0 * (double)nnz_a, NULL);
+            }
+        }
+        csr_destroy(cr);
+        matrix_destroy(ra);
+        free(perm);
+    }
+    csr_destroy(ca);
+    free(x);
+    free(y);
+
+    matrix_destroy(a);
+    matrix_destroy(b);
+    return 0;
+}
+
+static int le_opcao(const char *arg, const char *nome, const char **valor) {
+    size_t n = strlen(nome);
+    if (strncmp(arg, nome, n) != 0 || arg[n] != '=') return 0;
+    *valor = arg + n + 1;
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    Config c;
+    c.gerador = "todos";
+    c.n = 2000;
+    c.densidade = 0.005;
+    c.banda = 5;
+    c.grau_max = 500;
+    c.tam_bloco = 20;
+    c.densidade_bloco = 0.5;
+    c.reps = 3;
+    c.threads = 0;
+    c.semente = 42;
+    c.spmm_k = 32;
+
+    for (int a = 1; a < argc; a++) {
+        const char *v;
+        if (le_opcao(argv[a], "--gerador", &v)) c.gerador = v;
+        else if (le_opcao(argv[a], "--n", &v)) c.n = atoi(v);
+        else if (le_opcao(argv[a], "--densidade", &v)) c.densidade = atof(v);
+        else if (le_opcao(argv[a], "--banda", &v)) c.banda = atoi(v);
+        else if (le_opcao(argv[a], "--grau-max", &v)) c.grau_max = atoi(v);
+        else if (le_opcao(argv[a], "--bloco", &v)) c.tam_bloco = atoi(v);
+        else if (le_opcao(argv[a], "--densidade-bloco", &v)) c.densidade_bloco = atof(v);
+        else if (le_opcao(argv[a], "--reps", &v)) c.reps = atoi(v);
+        else if (le_opcao(argv[a], "--threads", &v)) c.threads = atoi(v);
+        else if (le_opcao(argv[a], "--semente", &v)) c.semente = (unsigned)strtoul(v, NULL, 10);
+        else if (le_opcao(argv[a], "--spmm-k", &v)) c.spmm_k = atoi(v);
+        else {
+            fprintf(stderr, "Opcao desconhecida: %s\n", argv[a]);
+            return 1;
+        }
+    }
+
+    if (c.n <= 0 || c.reps <= 0 || c.tam_bloco <= 0 || c.tam_bloco > c.n || c.spmm_k <= 0) {
+        fprintf(stderr, "Parametros invalidos.\n");
+        return 1;
+    }
+    c.threads = parallel_num_threads(c.threads);
+
+    static const char *geradores[] = {"uniform", "banded", "powerlaw", "blockdiag"};
+    int erro = 0;
+    for (int g = 0; g < 4; g++) {
+        if (strcmp(c.gerador, "todos") && strcmp(c.gerador, geradores[g])) continue;
+        /* blockdiag só gera blocos inteiros: relata a dimensão realmente construída */
+        Config cg = c;
+        if (!strcmp(geradores[g], "blockdiag")) cg.n = (c.n / c.tam_bloco) * c.tam_bloco;
+        erro |= bench_gerador(&cg, geradores[g]);
+    }
+
+    /* Com `make bench INSTRUMENT=1`, fecha com os contadores acumulados de todas as medições */
+    if (instr_ativo()) instr_dump_json(stdout);
+    return erro;
+}
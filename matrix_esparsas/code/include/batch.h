@@ -0,0 +1,28 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "dataclass.h"
+
+int matrix_setelem_batch(Matrix *m, const int *is, const int *js, const float *vals, int k);
+int matrix_getelem_batch(const Matrix *m, const int *is, const int *js, int k, float *out);
+
+/* ===== Lote ordenado e kernel por linha (usados também por parallel.c) ===== */
+
+/*
+ * Posições de um lote ordenadas por (linha, coluna): as entradas da linha i
+ * (base 0) são perm[inicio[i]] .. perm[inicio[i + 1] - 1], na ordem das colunas
+ * e, para a mesma coluna, na ordem em que aparecem no lote.
+ */
+typedef struct LoteOrdenado {
+    const int *js;
+    const float *vals;
+    int *perm;
+    int *inicio;
+} LoteOrdenado;
+
+int lote_ordena(const Matrix *m, const int *is, const int *js, const float *vals, int k, LoteOrdenado *l);
+void lote_free(LoteOrdenado *l);
+
+int matrix_setelem_batch_row(Matrix *m, const LoteOrdenado *l, int i, NoPool *pool);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef BINARY_H
+#define BINARY_H
+
+#include "dataclass.h"
+
+/* Versão atual do formato binário gravado por csr_save_binary. */
+#define BINARY_VERSAO 1
+
+int csr_save_binary(const char *caminho, const MatrixCSR *c);
+int matrix_save_binary(const char *caminho, const Matrix *m);
+
+int csr_map_binary(const char *caminho, MatrixCSR **r);
+int csr_unmap_binary(MatrixCSR *c);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef BSR_H
+#define BSR_H
+
+#include "dataclass.h"
+
+MatrixBSR* bsr_init(int linhas, int colunas, int nnzb);
+int bsr_destroy(MatrixBSR *c);
+
+int bsr_from_matrix(const Matrix *m, MatrixBSR **r);
+int bsr_to_matrix(const MatrixBSR *c, Matrix **r);
+
+int bsr_getelem(const MatrixBSR *c, int x, int y, float *elem);
+
+int bsr_add(const MatrixBSR *a, const MatrixBSR *b, MatrixBSR **r);
+int bsr_multiply(const MatrixBSR *a, const MatrixBSR *b, MatrixBSR **r);
+int bsr_spmv(const MatrixBSR *a, const float *x, float *y);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef COO_H
+#define COO_H
+
+#include "dataclass.h"
+
+int coo_sort_perm(int linhas, int colunas, const int *is, const int *js, int nnz, int *perm);
+
+int csr_from_coo(int linhas, int colunas, const int *is, const int *js,
+                 const float *vals, int nnz, MatrixCSR **r);
+int matrix_from_coo(int linhas, int colunas, const int *is, const int *js,
+                    const float *vals, int nnz, Matrix **r);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include "dataclass.h"
+
+MatrixCSR* csr_init(int linhas, int colunas, int nnz);
+int csr_destroy(MatrixCSR *c);
+
+int csr_from_matrix(const Matrix *m, MatrixCSR **r);
+int csr_to_matrix(const MatrixCSR *c, Matrix **r);
+
+int csr_getelem(const MatrixCSR *c, int x, int y, float *elem);
+
+int csr_add(const MatrixCSR *a, const MatrixCSR *b, MatrixCSR **r);
+int csr_transpose(const MatrixCSR *a, MatrixCSR **r);
+int csr_multiply(const MatrixCSR *a, const MatrixCSR *b, MatrixCSR **r);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef CSR_TIPADO_H
+#define CSR_TIPADO_H
+
+#include "dataclass.h"
+
+/*
+ * Operações CSR geradas para cada tipo de valor (sufixos _d e _i). As versões
+ * com valor float continuam sendo as de csr.h.
+ */
+#define CSR_TIPADO_PROTOTIPOS(SUF, T)                                                      \
+    MatrixCSR_##SUF* csr_init_##SUF(int linhas, int colunas, int nnz);                     \
+    int csr_destroy_##SUF(MatrixCSR_##SUF *c);                                             \
+    int csr_from_matrix_##SUF(const Matrix *m, MatrixCSR_##SUF **r);                       \
+    int csr_from_coo_##SUF(int linhas, int colunas, const int *is, const int *js,          \
+                           const T *vals, int nnz, MatrixCSR_##SUF **r);                   \
+    int csr_getelem_##SUF(const MatrixCSR_##SUF *c, int x, int y, T *elem);                \
+    int csr_add_##SUF(const MatrixCSR_##SUF *a, const MatrixCSR_##SUF *b,                  \
+                      MatrixCSR_##SUF **r);                                                \
+    int csr_transpose_##SUF(const MatrixCSR_##SUF *a, MatrixCSR_##SUF **r);                \
+    int csr_multiply_##SUF(const MatrixCSR_##SUF *a, const MatrixCSR_##SUF *b,             \
+                           MatrixCSR_##SUF **r);                                           \
+    int csr_spmv_##SUF(const MatrixCSR_##SUF *a, const T *x, T *y);
+
+CSR_TIPADO_PROTOTIPOS(d, double)
+CSR_TIPADO_PROTOTIPOS(i, int32_t)
+
+/* Variante de padrão: sem valores; a soma é a união e o produto é booleano. */
+MatrixCSR_p* csr_init_p(int linhas, int colunas, int nnz);
+int csr_destroy_p(MatrixCSR_p *c);
+int csr_from_matrix_p(const Matrix *m, MatrixCSR_p **r);
+int csr_from_coo_p(int linhas, int colunas, const int *is, const int *js, int nnz, MatrixCSR_p **r);
+int csr_getelem_p(const MatrixCSR_p *c, int x, int y, int *elem);
+int csr_add_p(const MatrixCSR_p *a, const MatrixCSR_p *b, MatrixCSR_p **r);
+int csr_transpose_p(const MatrixCSR_p *a, MatrixCSR_p **r);
+int csr_multiply_p(const MatrixCSR_p *a, const MatrixCSR_p *b, MatrixCSR_p **r);
+int csr_spmv_p(const MatrixCSR_p *a, const float *x, float *y);
+
+#endif
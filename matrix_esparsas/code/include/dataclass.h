@@ -1,6 +1,9 @@
 #ifndef DATACLASS_H
 #define DATACLASS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef struct No {
     int coluna;
     float valor;
@@ -9,10 +12,150 @@ typedef struct No {
 
 typedef No* POINT;
 
+/* Bloco contíguo de nós pertencente a um NoPool. */
+typedef struct Slab {
+    struct Slab *prox;
+    int capacidade;
+    int usados;
+    No nos[];
+} Slab;
+
+/*
+ * Alocador de nós de uma matriz: os nós vêm de slabs contíguos e os nós
+ * removidos voltam para a lista `livres` (encadeada por `prox`).
+ */
+typedef struct NoPool {
+    Slab *slabs;
+    No *livres;
+    int proximo_tam;
+    int nslabs;
+    long long alocados;
+    long long liberados;
+} NoPool;
+
+/*
+ * Índice opcional de uma linha: as colunas e os nós da lista em vetores
+ * contíguos, na mesma ordem da lista, para busca binária.
+ */
+typedef struct IndiceLinha {
+    int n;
+    int cap;
+    int *colunas;
+    No **nos;
+} IndiceLinha;
+
+/*
+ * `indice` é NULL enquanto o índice por linha estiver desligado; quando ligado
+ * (ver matrix_index_enable), tem uma entrada por linha.
+ */
 typedef struct Matrix {
     int linhas;
     int colunas;
     POINT *mat;
+    NoPool pool;
+    IndiceLinha *indice;
 } Matrix;
 
+/*
+ * Representação CSR (compressed sparse row) da matriz.
+ *
+ * Os elementos da linha i (base 0) ocupam as posições
+ * [row_ptr[i], row_ptr[i + 1]) de `col_idx` e `values`, ordenados por coluna.
+ * Diferente de `No.coluna`, `col_idx` guarda colunas com base 0.
+ *
+ * Quando `mapa` não é NULL, os vetores apontam para um arquivo binário mapeado
+ * em memória (somente leitura) e são liberados junto com o mapeamento.
+ */
+typedef struct MatrixCSR {
+    int linhas;
+    int colunas;
+    int nnz;
+    int *row_ptr;
+    int *col_idx;
+    float *values;
+    void *mapa;
+    size_t mapa_tam;
+} MatrixCSR;
+
+/*
+ * Variantes CSR com outros tipos de valor (ver csr_tipado.h), com o mesmo
+ * layout de MatrixCSR: _d guarda double e _i guarda int32. A variante de
+ * padrão (_p) guarda apenas a estrutura, sem vetor de valores: todo elemento
+ * armazenado vale 1.
+ */
+typedef struct MatrixCSR_d {
+    int linhas;
+    int colunas;
+    int nnz;
+    int *row_ptr;
+    int *col_idx;
+    double *values;
+} MatrixCSR_d;
+
+typedef struct MatrixCSR_i {
+    int linhas;
+    int colunas;
+    int nnz;
+    int *row_ptr;
+    int *col_idx;
+    int32_t *values;
+} MatrixCSR_i;
+
+typedef struct MatrixCSR_p {
+    int linhas;
+    int colunas;
+    int nnz;
+    int *row_ptr;
+    int *col_idx;
+} MatrixCSR_p;
+
+/*
+ * Representação BSR (block sparse row): a matriz é dividida em blocos densos
+ * de BSR_BLOCO x BSR_BLOCO e só os blocos com algum elemento são guardados.
+ * O tamanho do bloco é fixo em tempo de compilação (-DBSR_BLOCO=3, por
+ * exemplo), para que os laços dos kernels tenham trip count constante.
+ *
+ * A linha de blocos bi (base 0) ocupa as posições [row_ptr[bi], row_ptr[bi + 1])
+ * de `col_idx` (coluna de bloco, base 0, ordenada). O bloco k ocupa
+ * values[k * BSR_BLOCO * BSR_BLOCO ...] em ordem de coluna: o elemento
+ * (r, c) do bloco fica em c * BSR_BLOCO + r. Quando `linhas`/`colunas` não são
+ * múltiplos de BSR_BLOCO, os blocos da borda são completados com zeros.
+ */
+#ifndef BSR_BLOCO
+#define BSR_BLOCO 4
+#endif
+
+typedef struct MatrixBSR {
+    int linhas;
+    int colunas;
+    int blinhas;
+    int bcolunas;
+    int nnzb;
+    int *row_ptr;
+    int *col_idx;
+    float *values;
+} MatrixBSR;
+
+/*
+ * Linha da representação híbrida (ver hibrida.h). Na forma esparsa, as nnz
+ * colunas (base 0, ordenadas) e valores ficam em `col_idx`/`values`, com
+ * capacidade `cap`. Na forma densa (`densa` != 0), `values` tem `colunas`
+ * posições (0.0 onde não há elemento), `bits` marca as colunas presentes e
+ * `col_idx` é NULL.
+ */
+typedef struct LinhaHibrida {
+    int nnz;
+    int cap;
+    int densa;
+    int *col_idx;
+    float *values;
+    uint64_t *bits;
+} LinhaHibrida;
+
+typedef struct MatrixHibrida {
+    int linhas;
+    int colunas;
+    LinhaHibrida *rows;
+} MatrixHibrida;
+
 #endif
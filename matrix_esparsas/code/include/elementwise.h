@@ -0,0 +1,30 @@
+#ifndef ELEMENTWISE_H
+#define ELEMENTWISE_H
+
+#include "dataclass.h"
+
+/*
+ * Na interseção de duas linhas, se uma tiver pelo menos HADAMARD_GALOPE vezes
+ * mais elementos que a outra (e puder ser acessada por posição: CSR ou índice
+ * por linha ligado), a curta é percorrida e a longa é buscada com busca
+ * galopante, em vez de intercalar as duas.
+ */
+#ifndef HADAMARD_GALOPE
+#define HADAMARD_GALOPE 8
+#endif
+
+/* Função aplicada a cada elemento armazenado (i e j com base 1). */
+typedef float (*FuncaoElemento)(float valor, int i, int j, void *dados);
+
+int matrix_hadamard(const Matrix *m, const Matrix *n, Matrix **r);
+int matrix_hadamard_inplace(Matrix *m, const Matrix *n);
+int csr_hadamard(const MatrixCSR *a, const MatrixCSR *b, MatrixCSR **r);
+
+int matrix_mask(const Matrix *m, const Matrix *mascara, int complemento, Matrix **r);
+int matrix_mask_inplace(Matrix *m, const Matrix *mascara, int complemento);
+
+int matrix_scale(Matrix *m, float alfa);
+int matrix_apply(Matrix *m, FuncaoElemento f, void *dados);
+int matrix_drop(Matrix *m, float limiar);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef FUSED_H
+#define FUSED_H
+
+#include "dataclass.h"
+
+int matrix_gemm(float alfa, const Matrix *a, const Matrix *b, float beta, Matrix *c);
+int matrix_multiply_tn(const Matrix *a, const Matrix *b, Matrix **r);
+int matrix_add_n(const Matrix *const *ms, const float *coef, int n, Matrix **r);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include "dataclass.h"
+
+int generate_uniform(int linhas, int colunas, double densidade, unsigned semente, Matrix **r);
+int generate_banded(int n, int banda, unsigned semente, Matrix **r);
+int generate_powerlaw(int linhas, int colunas, int grau_max, unsigned semente, Matrix **r);
+int generate_block_diagonal(int nblocos, int tam_bloco, double densidade, unsigned semente, Matrix **r);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef HIBRIDA_H
+#define HIBRIDA_H
+
+#include "dataclass.h"
+
+/*
+ * Uma linha passa para a forma densa quando ocupa pelo menos
+ * HIBRIDA_DENSA_PCT% das colunas e volta para a esparsa abaixo de
+ * HIBRIDA_ESPARSA_PCT%; a folga entre os dois evita trocas sucessivas
+ * quando a ocupação oscila perto do limite.
+ */
+#ifndef HIBRIDA_DENSA_PCT
+#define HIBRIDA_DENSA_PCT 50
+#endif
+#ifndef HIBRIDA_ESPARSA_PCT
+#define HIBRIDA_ESPARSA_PCT 25
+#endif
+
+MatrixHibrida* hibrida_init(int linhas, int colunas);
+int hibrida_destroy(MatrixHibrida *h);
+
+int hibrida_from_matrix(const Matrix *m, MatrixHibrida **r);
+int hibrida_to_matrix(const MatrixHibrida *h, Matrix **r);
+
+int hibrida_getelem(const MatrixHibrida *h, int i, int j, float *elem);
+int hibrida_setelem(MatrixHibrida *h, int i, int j, float valor);
+int hibrida_addelem(MatrixHibrida *h, int i, int j, float delta);
+int hibrida_linhas_densas(const MatrixHibrida *h);
+
+int hibrida_add(const MatrixHibrida *a, const MatrixHibrida *b, MatrixHibrida **r);
+int hibrida_multiply(const MatrixHibrida *a, const MatrixHibrida *b, MatrixHibrida **r);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef INDICE_H
+#define INDICE_H
+
+#include "dataclass.h"
+
+int matrix_index_enable(Matrix *m);
+void matrix_index_disable(Matrix *m);
+
+/* ===== Acesso a uma linha, mantendo o índice (usados pelas operações que alteram a matriz) ===== */
+
+POINT linha_localiza(const Matrix *m, int linha, int j, POINT *anterior, int *pos);
+int linha_insere(Matrix *m, int linha, POINT anterior, int pos, int j, float valor);
+void linha_remove(Matrix *m, int linha, POINT anterior, POINT atual, int pos);
+int indice_reconstroi_linha(Matrix *m, int linha);
+
+#endif
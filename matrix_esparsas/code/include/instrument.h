@@ -0,0 +1,66 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <stdio.h>
+
+/*
+ * Contadores de instrumentação das operações principais, ligados em tempo de
+ * compilação com -DMATRIX_INSTRUMENT (ou `make INSTRUMENT=1`). Sem a flag, as
+ * macros abaixo não geram código e as funções só devolvem zeros.
+ */
+
+typedef enum InstrOp {
+    INSTR_ADD = 0,
+    INSTR_MULTIPLY = 1,
+    INSTR_TRANSPOSE = 2,
+    INSTR_SETELEM = 3,
+    INSTR_NOPS = 4
+} InstrOp;
+
+typedef struct InstrContadores {
+    long long chamadas;
+    long long ns;
+    long long passos;        /* nós visitados ao percorrer listas (ou passos da busca no índice) */
+    long long produtos;      /* produtos parciais */
+    long long flops;
+    long long nos_alocados;
+    long long nos_liberados;
+} InstrContadores;
+
+int instr_ativo(void);
+const char* instr_nome(InstrOp op);
+void instr_zera(void);
+int instr_le(InstrOp op, InstrContadores *c);
+int instr_dump_json(FILE *f);
+
+#ifdef MATRIX_INSTRUMENT
+
+#include "timer.h"
+
+/* Passos de `linha_localiza` na thread atual (lidos por diferença). */
+extern _Thread_local long long instr_passos_thread;
+
+void instr_soma(InstrOp op, long long passos, long long produtos, long long flops);
+void instr_registra(InstrOp op, long long ns, long long passos, long long produtos, long long flops,
+                    long long nos_alocados, long long nos_liberados);
+
+#define INSTR_VAR(v, valor) long long v = (valor)
+#define INSTR_CONTA(v, k) ((v) += (k))
+#define INSTR_CONTA_THREAD(k) (instr_passos_thread += (k))
+#define INSTR_INICIO(t0) long long t0 = timer_ns()
+#define INSTR_SOMA(op, passos, produtos, flops) instr_soma((op), (passos), (produtos), (flops))
+#define INSTR_FIM(op, t0, passos, produtos, flops, alocados, liberados) \
+    instr_registra((op), timer_ns() - (t0), (passos), (produtos), (flops), (alocados), (liberados))
+
+#else
+
+#define INSTR_VAR(v, valor) ((void)0)
+#define INSTR_CONTA(v, k) ((void)0)
+#define INSTR_CONTA_THREAD(k) ((void)0)
+#define INSTR_INICIO(t0) ((void)0)
+#define INSTR_SOMA(op, passos, produtos, flops) ((void)0)
+#define INSTR_FIM(op, t0, passos, produtos, flops, alocados, liberados) ((void)0)
+
+#endif
+
+#endif
@@ -3,8 +3,29 @@
 
 #include "dataclass.h"
 
+int matrix_addelem(Matrix *m, int i, int j, float delta);
 int matrix_add(const Matrix *m, const Matrix *n, Matrix **r);
+int matrix_add_inplace(Matrix *a, const Matrix *b);
+int matrix_axpy(Matrix *a, float alfa, const Matrix *b);
 int matrix_multiply(const Matrix *m, const Matrix *n, Matrix **r);
 int matrix_transpose(const Matrix *m, Matrix **r);
+int matrix_transpose_blocked(const Matrix *m, int bloco, Matrix **r);
+
+/* ===== Kernels por linha (usados também por parallel.c) ===== */
+
+/* Vetores de trabalho do produto de Gustavson para uma linha de saída. */
+typedef struct Acumulador {
+    int q;
+    double *acc;
+    int *marca;
+    int *tocadas;
+} Acumulador;
+
+int acumulador_init(Acumulador *a, int q);
+void acumulador_free(Acumulador *a);
+int acumulador_emite(Acumulador *a, int i, int ntoc, NoPool *pool, POINT *saida);
+
+int matrix_add_row(const Matrix *m, const Matrix *n, int i, NoPool *pool, POINT *saida);
+int matrix_multiply_row(const Matrix *m, const Matrix *n, int i, Acumulador *a, NoPool *pool, POINT *saida);
 
 #endif
@@ -0,0 +1,12 @@
+#ifndef MTX_H
+#define MTX_H
+
+#include "dataclass.h"
+
+int csr_read_mtx(const char *caminho, MatrixCSR **r);
+int matrix_read_mtx(const char *caminho, Matrix **r);
+
+int csr_write_mtx(const char *caminho, const MatrixCSR *c);
+int matrix_write_mtx(const char *caminho, const Matrix *m);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "dataclass.h"
+
+int parallel_num_threads(int nthreads);
+void parallel_partition(const long long *prefixo, int linhas, int partes, int *limites);
+
+int matrix_add_parallel(const Matrix *m, const Matrix *n, Matrix **r, int nthreads);
+int matrix_multiply_parallel(const Matrix *m, const Matrix *n, Matrix **r, int nthreads);
+int matrix_setelem_batch_parallel(Matrix *m, const int *is, const int *js, const float *vals, int k, int nthreads);
+
+/*
+ * Plano do SpMV paralelo: a cópia de A (com as páginas de cada faixa tocadas
+ * pela thread da faixa) e, para cada thread t, o trecho do caminho de
+ * intercalação que vai de (linha[t], pos[t]) a (linha[t + 1], pos[t + 1]).
+ * `cpu[t]` é o processador da thread t (-1 sem afinidade) e ns_thread[t] o
+ * tempo dela no último csr_spmv_parallel. `equipe` guarda as threads do
+ * plano, criadas uma vez e reaproveitadas a cada chamada.
+ */
+typedef struct PlanoSpmv {
+    int nthreads;
+    MatrixCSR *a;
+    int *linha;
+    int *pos;
+    int *cpu;
+    float *carry;
+    long long *ns_thread;
+    struct EquipeSpmv *equipe;
+} PlanoSpmv;
+
+int plano_spmv_init(const MatrixCSR *a, int nthreads, PlanoSpmv **p);
+void plano_spmv_destroy(PlanoSpmv *p);
+int csr_spmv_parallel(PlanoSpmv *p, const float *x, float *y);
+
+int csr_spmm_parallel(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int nthreads);
+
+#endif
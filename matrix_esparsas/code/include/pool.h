@@ -0,0 +1,14 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "dataclass.h"
+
+void pool_init(NoPool *p);
+void pool_destroy(NoPool *p);
+
+No* pool_alloc(NoPool *p);
+void pool_free(NoPool *p, No *no);
+int pool_reserve(NoPool *p, int n);
+void pool_merge(NoPool *dst, NoPool *src);
+
+#endif
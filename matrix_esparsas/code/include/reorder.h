@@ -0,0 +1,29 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "dataclass.h"
+
+typedef enum OrdemTipo {
+    ORDEM_RCM = 0,
+    ORDEM_GRAU = 1
+} OrdemTipo;
+
+/* Largura de banda e perfil antes e depois de uma reordenação. */
+typedef struct RelatorioOrdem {
+    int banda_antes;
+    int banda_depois;
+    long long perfil_antes;
+    long long perfil_depois;
+} RelatorioOrdem;
+
+int reorder_rcm(const Matrix *m, int *perm);
+int reorder_degree(const Matrix *m, int *perm);
+
+int matrix_permute(const Matrix *m, const int *perm, Matrix **r);
+int matrix_bandwidth(const Matrix *m, int *banda, long long *perfil);
+int matrix_reorder(const Matrix *m, OrdemTipo tipo, int *perm, Matrix **r, RelatorioOrdem *rel);
+
+int vector_permute(const float *x, const int *perm, int n, float *y);
+int vector_unpermute(const float *y, const int *perm, int n, float *x);
+
+#endif
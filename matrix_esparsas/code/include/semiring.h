@@ -0,0 +1,32 @@
+#ifndef SEMIRING_H
+#define SEMIRING_H
+
+#include "dataclass.h"
+
+/*
+ * Produtos CSR sobre semianéis (soma ⊕, produto ⊗), gerados em tempo de
+ * compilação a partir de semiring_modelo.h: cada semianel tem seus próprios
+ * laços, com as operações expandidas, sem ponteiros de função. Os elementos
+ * não armazenados valem o zero do semianel (identidade de ⊕).
+ *
+ *   plus_times  (+, ×)    zero 0      produto usual (acumula em double);
+ *   min_plus    (min, +)  zero +inf   caminhos mínimos;
+ *   max_times   (max, ×)  zero -inf   caminhos de maior confiabilidade;
+ *   lor_land    (ou, e)   zero 0      alcançabilidade (resultado 0 ou 1).
+ *
+ * Outros semianéis podem ser gerados pelo usuário incluindo
+ * semiring_modelo.h (ver o exemplo no início dele) e declarados com
+ * SEMIRING_PROTOTIPOS.
+ */
+#define SEMIRING_PROTOTIPOS(SUF)                                                           \
+    int csr_mxm_##SUF(const MatrixCSR *a, const MatrixCSR *b, const MatrixCSR *mascara,    \
+                      int complemento, MatrixCSR **r);                                     \
+    int csr_mxv_##SUF(const MatrixCSR *a, const float *x, const float *mascara,            \
+                      int complemento, float *y);
+
+SEMIRING_PROTOTIPOS(plus_times)
+SEMIRING_PROTOTIPOS(min_plus)
+SEMIRING_PROTOTIPOS(max_times)
+SEMIRING_PROTOTIPOS(lor_land)
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ * Modelo do produto CSR sobre um semianel, incluído uma vez por semianel
+ * (por semiring.c para os semianéis prontos, ou pelo usuário para os seus).
+ * Não tem include guard de propósito: cada inclusão gera `csr_mxm_<SR_SUF>` e
+ * `csr_mxv_<SR_SUF>`, com as operações do semianel expandidas nos laços.
+ *
+ * Parâmetros, definidos antes da inclusão e desfeitos ao final:
+ *   SR_SUF            sufixo das funções geradas (ex.: min_plus);
+ *   SR_ACUM           tipo usado para acumular (ex.: float, double);
+ *   SR_ZERO           identidade da soma, que é também o valor dos elementos
+ *                     não armazenados (ex.: +inf no min-plus);
+ *   SR_SOMA(x, y)     soma do semianel (associativa e comutativa);
+ *   SR_PRODUTO(x, y)  produto do semianel;
+ *   SR_TERMINAL       opcional: valor absorvente da soma (ex.: 1 no or-and);
+ *                     ao atingi-lo, o produto matriz-vetor encerra a linha.
+ *
+ * Exemplo (semianel max-min, de caminhos de maior gargalo):
+ *
+ *     #define SR_SUF max_min
+ *     #define SR_ACUM float
+ *     #define SR_ZERO (-__builtin_inff())
+ *     #define SR_SOMA(x, y) ((x) > (y) ? (x) : (y))
+ *     #define SR_PRODUTO(x, y) ((x) < (y) ? (x) : (y))
+ *     #include "semiring_modelo.h"
+ *     #undef SR_SUF ...
+ *
+ * e, onde for usado, `SEMIRING_PROTOTIPOS(max_min)` (semiring.h).
+ */
+
+#include <stdlib.h>
+#include "csr.h"
+
+#ifndef SEMIRING_MODELO_AUX
+#define SEMIRING_MODELO_AUX
+static int semiring_cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+#endif
+
+#define SR_JUNTA_(a, b) a##_##b
+#define SR_JUNTA(a, b) SR_JUNTA_(a, b)
+#define SR_F(nome) SR_JUNTA(nome, SR_SUF)
+
+/* Com máscara, a coluna j da linha i só entra no resultado se estiver (ou, com complemento, não estiver) na máscara. */
+#define SR_BLOQUEADA(j, i) (mascara && ((marca_m[j] == (i)) == complemento))
+
+/**
+ * @brief Produto C<M> = A ⊕.⊗ B de duas matrizes CSR sobre o semianel SR_SUF.
+ *
+ * Algoritmo de Gustavson, como em `csr_multiply`: passada simbólica que conta
+ * as colunas de cada linha (já restritas pela máscara) e passada numérica que
+ * acumula a linha em um vetor denso de SR_ACUM. O primeiro produto de cada
+ * coluna inicializa o acumulador; os seguintes entram com SR_SOMA. Os
+ * elementos cujo valor final é SR_ZERO não são armazenados.
+ *
+ * A máscara é estrutural (vale a presença do elemento, não o valor): com
+ * `complemento == 0`, só as posições armazenadas em `mascara` são calculadas;
+ * com `complemento != 0`, só as que não estão. Os produtos de posições
+ * bloqueadas nem chegam a ser somados. Sem complemento, as linhas saem na
+ * ordem da máscara e não precisam ser ordenadas.
+ *
+ * @param a Ponteiro constante para a matriz à esquerda (m x p).
+ * @param b Ponteiro constante para a matriz à direita (p x q).
+ * @param mascara Máscara (m x q) ou NULL para calcular todas as posições.
+ * @param complemento Se diferente de 0, usa o complemento da máscara.
+ * @param r Endereço de ponteiro que receberá o produto (m x q).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro (exceto `mascara`) for NULL, se as dimensões
+ *         forem incompatíveis ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int SR_F(csr_mxm)(const MatrixCSR *a, const MatrixCSR *b, const MatrixCSR *mascara, int complemento, MatrixCSR **r) {
+    if (!a || !b || !r) return 1;
+    if (a->colunas != b->linhas) return 1;
+    if (mascara && (mascara->linhas != a->linhas || mascara->colunas != b->colunas)) return 1;
+    *r = NULL;
+    complemento = complemento != 0;
+
+    int q = b->colunas;
+    int *marca = (int*)malloc((size_t)q * sizeof(int));
+    int *marca_m = (int*)malloc((size_t)q * sizeof(int));
+    SR_ACUM *acc = (SR_ACUM*)malloc((size_t)q * sizeof(SR_ACUM));
+    if (!marca || !marca_m || !acc) {
+        free(marca);
+        free(marca_m);
+        free(acc);
+        return 1;
+    }
+    for (int j = 0; j < q; j++) marca[j] = marca_m[j] = -1;
+
+    /* passada simbólica: nnz estrutural de cada linha, já com a máscara */
+    long long total = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        if (mascara) {
+            for (int km = mascara->row_ptr[i]; km < mascara->row_ptr[i + 1]; km++) marca_m[mascara->col_idx[km]] = i;
+        }
+        for (int ka = a->row_ptr[i]; ka < a->row_ptr[i + 1]; ka++) {
+            int k = a->col_idx[ka];
+            for (int kb = b->row_ptr[k]; kb < b->row_ptr[k + 1]; kb++) {
+                int j = b->col_idx[kb];
+                if (marca[j] == i || SR_BLOQUEADA(j, i)) continue;
+                marca[j] = i;
+                total++;
+            }
+        }
+    }
+
+    MatrixCSR *c = (total > 0x7fffffff) ? NULL : csr_init(a->linhas, q, (int)total);
+    if (!c) {
+        free(marca);
+        free(marca_m);
+        free(acc);
+        return 1;
+    }
+    for (int j = 0; j < q; j++) marca[j] = marca_m[j] = -1;
+
+    /* passada numérica */
+    int k_out = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int ini = k_out;
+        c->row_ptr[i] = ini;
+        if (mascara) {
+            for (int km = mascara->row_ptr[i]; km < mascara->row_ptr[i + 1]; km++) marca_m[mascara->col_idx[km]] = i;
+        }
+
+        for (int ka = a->row_ptr[i]; ka < a->row_ptr[i + 1]; ka++) {
+            int k = a->col_idx[ka];
+            SR_ACUM va = a->values[ka];
+            for (int kb = b->row_ptr[k]; kb < b->row_ptr[k + 1]; kb++) {
+                int j = b->col_idx[kb];
+                if (SR_BLOQUEADA(j, i)) continue;
+
+                SR_ACUM p = SR_PRODUTO(va, (SR_ACUM)b->values[kb]);
+                if (marca[j] != i) {
+                    marca[j] = i;
+                    acc[j] = p;
+                    c->col_idx[k_out++] = j;
+                } else {
+                    acc[j] = SR_SOMA(acc[j], p);
+                }
+            }
+        }
+
+        if (mascara && !complemento) {
+            /* as colunas tocadas são um subconjunto da linha da máscara, já ordenada */
+            for (int km = mascara->row_ptr[i]; km < mascara->row_ptr[i + 1]; km++) {
+                int j = mascara->col_idx[km];
+                if (marca[j] == i) c->col_idx[ini++] = j;
+            }
+            ini = c->row_ptr[i];
+        } else {
+            qsort(c->col_idx + ini, (size_t)(k_out - ini), sizeof(int), semiring_cmp_int);
+        }
+
+        int w = ini;
+        for (int t = ini; t < k_out; t++) {
+            int j = c->col_idx[t];
+            float v = (float)acc[j];
+            if (v != (float)(SR_ZERO)) {
+                c->col_idx[w] = j;
+                c->values[w] = v;
+                w++;
+            }
+        }
+        k_out = w;
+    }
+    c->row_ptr[a->linhas] = k_out;
+    c->nnz = k_out;
+
+    free(marca);
+    free(marca_m);
+    free(acc);
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Produto matriz-vetor y<m> = A ⊕.⊗ x sobre o semianel SR_SUF.
+ *
+ * y[i] é a soma (SR_SOMA), a partir de SR_ZERO, de A(i, k) ⊗ x[k] sobre os
+ * elementos armazenados da linha i. As posições de `x` sem valor devem conter
+ * SR_ZERO. Com SR_TERMINAL definido, a linha termina assim que a soma o atinge.
+ *
+ * Com máscara, só as posições i com `mascara[i] != 0` (ou, com complemento,
+ * `mascara[i] == 0`) são calculadas; as demais recebem SR_ZERO. Na busca em
+ * largura, por exemplo, a máscara é o vetor de visitados, com complemento.
+ *
+ * @param a Ponteiro constante para a matriz (linhas x colunas).
+ * @param x Vetor denso com a->colunas posições.
+ * @param mascara Vetor com a->linhas posições ou NULL para calcular todas.
+ * @param complemento Se diferente de 0, usa o complemento da máscara.
+ * @param y Vetor denso com a->linhas posições (sobrescrito; não pode ser `x`).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `a`, `x` ou `y` forem NULL.
+ */
+int SR_F(csr_mxv)(const MatrixCSR *a, const float *x, const float *mascara, int complemento, float *y) {
+    if (!a || !x || !y) return 1;
+
+    for (int i = 0; i < a->linhas; i++) {
+        if (mascara && ((mascara[i] != 0.0f) == (complemento != 0))) {
+            y[i] = (float)(SR_ZERO);
+            continue;
+        }
+
+        SR_ACUM soma = SR_ZERO;
+        for (int k = a->row_ptr[i]; k < a->row_ptr[i + 1]; k++) {
+            soma = SR_SOMA(soma, SR_PRODUTO((SR_ACUM)a->values[k], (SR_ACUM)x[a->col_idx[k]]));
+#ifdef SR_TERMINAL
+            if (soma == (SR_TERMINAL)) break;
+#endif
+        }
+        y[i] = (float)soma;
+    }
+    return 0;
+}
+
+#undef SR_JUNTA_
+#undef SR_JUNTA
+#undef SR_F
+#undef SR_BLOQUEADA
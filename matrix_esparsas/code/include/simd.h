@@ -0,0 +1,21 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/* Kernels com intrínsecos x86 só são compilados com GCC/Clang em x86. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#else
+#define SIMD_X86 0
+#endif
+
+typedef enum SimdNivel {
+    SIMD_ESCALAR = 0,
+    SIMD_AVX2 = 1,
+    SIMD_AVX512 = 2
+} SimdNivel;
+
+SimdNivel simd_nivel(void);
+SimdNivel simd_set_nivel(SimdNivel nivel);
+const char* simd_nome(SimdNivel nivel);
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "dataclass.h"
+
+/* ===== Pré-condicionadores ===== */
+
+typedef enum PrecondTipo {
+    PRECOND_NENHUM = 0,
+    PRECOND_JACOBI = 1,
+    PRECOND_ILU0 = 2
+} PrecondTipo;
+
+/*
+ * Pré-condicionador M ≈ A. Jacobi guarda 1 / diag(A); ILU(0) guarda os
+ * fatores L (diagonal unitária, implícita) e U na mesma estrutura de A, em
+ * `lu`, com a posição da diagonal de cada linha em `pos_diag`.
+ */
+typedef struct Precondicionador {
+    PrecondTipo tipo;
+    int n;
+    float *diag_inv;
+    MatrixCSR *lu;
+    int *pos_diag;
+} Precondicionador;
+
+int precond_init(const MatrixCSR *a, PrecondTipo tipo, Precondicionador **p);
+void precond_destroy(Precondicionador *p);
+int precond_aplica(const Precondicionador *p, const float *r, float *z);
+
+/* ===== Solvers iterativos ===== */
+
+/*
+ * Chamado ao fim de cada iteração com o resíduo relativo ||r|| / ||b||.
+ * Retornar diferente de 0 interrompe o solver.
+ */
+typedef int (*SolverCallback)(int iteracao, double residuo, void *dados);
+
+#define SOLVER_NVETORES 8
+
+/*
+ * Espaço de trabalho reutilizável: os vetores auxiliares (n posições cada) e
+ * o tempo de cada iteração, em ns, para até `max_iter` iterações. Os solvers
+ * não alocam nada durante as iterações.
+ */
+typedef struct SolverWork {
+    int n;
+    int max_iter;
+    float *v[SOLVER_NVETORES];
+    long long *ns_iter;
+} SolverWork;
+
+typedef struct SolverOpcoes {
+    int max_iter;
+    double tol;
+    const Precondicionador *precond;
+    SolverCallback callback;
+    void *dados;
+} SolverOpcoes;
+
+typedef struct SolverResultado {
+    int iteracoes;
+    double residuo;
+    long long ns_total;
+    long long ns_spmv;
+    long long ns_precond;
+} SolverResultado;
+
+SolverWork* solver_work_init(int n, int max_iter);
+void solver_work_destroy(SolverWork *w);
+
+int solver_cg(const MatrixCSR *a, const float *b, float *x, const SolverOpcoes *op, SolverWork *w, SolverResultado *res);
+int solver_bicgstab(const MatrixCSR *a, const float *b, float *x, const SolverOpcoes *op, SolverWork *w, SolverResultado *res);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SPGEMM_H
+#define SPGEMM_H
+
+#include "dataclass.h"
+
+/*
+ * Plano de um produto A * B com estrutura fixa, calculado por
+ * matrix_multiply_symbolic. Para cada produto parcial A(i, k) * B(k, j), na
+ * ordem em que as listas são percorridas, `destino` guarda a posição (na ordem
+ * das linhas do resultado) do elemento (i, j) onde ele é somado.
+ */
+typedef struct PlanoProduto {
+    int linhas;
+    int colunas;
+    int nnz;
+    long long nprod;
+    int *destino;
+    double *acc;
+} PlanoProduto;
+
+int matrix_multiply_symbolic(const Matrix *a, const Matrix *b, PlanoProduto **plano, Matrix **r);
+int matrix_multiply_numeric(PlanoProduto *plano, const Matrix *a, const Matrix *b, Matrix *r);
+void plano_produto_destroy(PlanoProduto *plano);
+
+#endif
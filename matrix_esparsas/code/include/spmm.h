@@ -0,0 +1,23 @@
+#ifndef SPMM_H
+#define SPMM_H
+
+#include "dataclass.h"
+
+/*
+ * Produto matriz esparsa por matriz densa, C = A * B. B tem a->colunas linhas
+ * e `k` colunas, C tem a->linhas linhas e `k` colunas, ambas guardadas por
+ * linha: o elemento (i, j) de B fica em b[i * ldb + j] (ldb >= k), e o mesmo
+ * para C com ldc.
+ */
+
+int matrix_spmm(const Matrix *a, const float *b, int k, int ldb, float *c, int ldc);
+int csr_spmm(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc);
+
+/* ===== Kernel por faixa de linhas (usado também por parallel.c) ===== */
+
+typedef void (*KernelSpmm)(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int ini, int fim);
+
+KernelSpmm csr_spmm_kernel(int k);
+void csr_spmm_faixa(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int ini, int fim);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef SPMV_H
+#define SPMV_H
+
+#include "dataclass.h"
+
+int matrix_spmv(const Matrix *a, const float *x, float *y);
+int matrix_spmv_t(const Matrix *a, const float *x, float *y);
+
+int csr_spmv(const MatrixCSR *a, const float *x, float *y);
+int csr_spmv_t(const MatrixCSR *a, const float *x, float *y);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+long long timer_ns(void);
+
+#endif
@@ -0,0 +1,185 @@
+#include <stdlib.h>
+#include "batch.h"
+#include "coo.h"
+#include "indice.h"
+#include "pool.h"
+
+/**
+ * @brief Ordena um lote de posições (i, j) por linha e coluna.
+ *
+ * Usa `coo_sort_perm` (estável) e calcula onde começam as entradas de cada linha.
+ *
+ * @param m Ponteiro constante para a matriz (define os limites dos índices).
+ * @param is Índices de linha (base 1).
+ * @param js Índices de coluna (base 1).
+ * @param vals Valores do lote (pode ser NULL em consultas).
+ * @param k Número de posições.
+ * @param l Lote a preencher; liberar com `lote_free`.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se falhar alguma alocação.
+ * @return 2 se algum índice estiver fora dos limites.
+ */
+int lote_ordena(const Matrix *m, const int *is, const int *js, const float *vals, int k, LoteOrdenado *l) {
+    if (!m || !m->mat || !l || k < 0) return 1;
+
+    l->js = js;
+    l->vals = vals;
+    l->perm = (int*)malloc((k ? (size_t)k : 1) * sizeof(int));
+    l->inicio = (int*)calloc((size_t)m->linhas + 1, sizeof(int));
+    if (!l->perm || !l->inicio) {
+        lote_free(l);
+        return 1;
+    }
+
+    int erro = coo_sort_perm(m->linhas, m->colunas, is, js, k, l->perm);
+    if (erro) {
+        lote_free(l);
+        return erro;
+    }
+
+    for (int t = 0; t < k; t++) l->inicio[is[t]]++;
+    for (int i = 0; i < m->linhas; i++) l->inicio[i + 1] += l->inicio[i];
+    return 0;
+}
+
+void lote_free(LoteOrdenado *l) {
+    if (!l) return;
+
+    free(l->perm);
+    free(l->inicio);
+    l->perm = NULL;
+    l->inicio = NULL;
+}
+
+/**
+ * @brief Aplica à linha i as entradas de um lote ordenado, em uma única passada.
+ *
+ * Percorre a lista da linha e as colunas do lote ao mesmo tempo, inserindo,
+ * atualizando ou removendo nós conforme `matrix_setelem`. Se a mesma coluna
+ * aparecer mais de uma vez, vale a última ocorrência no lote. Custo
+ * O(nnz_linha + entradas da linha). Se o índice por linha estiver ligado, o
+ * índice da linha é refeito ao final.
+ *
+ * @param m Ponteiro para a matriz.
+ * @param l Lote ordenado por `lote_ordena`.
+ * @param i Índice da linha (base 0).
+ * @param pool Alocador de onde saem os novos nós e para onde vão os removidos.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se falhar alguma alocação (as entradas anteriores da linha já foram aplicadas).
+ */
+int matrix_setelem_batch_row(Matrix *m, const LoteOrdenado *l, int i, NoPool *pool) {
+    int t = l->inicio[i];
+    int fim = l->inicio[i + 1];
+    if (t == fim) return 0;
+
+    POINT *elo = &m->mat[i];
+    int erro = 0;
+
+    while (t < fim && !erro) {
+        int j = l->js[l->perm[t]];
+        while (t + 1 < fim && l->js[l->perm[t + 1]] == j) t++;
+        float valor = l->vals[l->perm[t]];
+        t++;
+
+        while (*elo && (*elo)->coluna < j) elo = &(*elo)->prox;
+        No *atual = *elo;
+
+        if (atual && atual->coluna == j) {
+            if (valor == 0.0f) {
+                *elo = atual->prox;
+                pool_free(pool, atual);
+            } else {
+                atual->valor = valor;
+                elo = &atual->prox;
+            }
+        } else if (valor != 0.0f) {
+            No *novo = pool_alloc(pool);
+            if (!novo) {
+                erro = 1;
+                break;
+            }
+            novo->coluna = j;
+            novo->valor = valor;
+            novo->prox = atual;
+            *elo = novo;
+            elo = &novo->prox;
+        }
+    }
+
+    if (m->indice && indice_reconstroi_linha(m, i)) erro = 1;
+    return erro;
+}
+
+/**
+ * @brief Aplica um lote de atribuições (i, j, valor) à matriz.
+ *
+ * Equivale a chamar `matrix_setelem` para cada posição, na ordem do lote
+ * (valor 0.0 remove o elemento; repetições: vale a última), mas ordena o lote
+ * por (linha, coluna) com radix sort e aplica cada linha em uma única passada
+ * sobre a lista, em vez de recomeçar da cabeça a cada elemento.
+ *
+ * @param m Ponteiro para a matriz.
+ * @param is Índices de linha (base 1).
+ * @param js Índices de coluna (base 1).
+ * @param vals Valores.
+ * @param k Número de posições.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se falhar alguma alocação; nesse
+ *         caso, parte do lote pode já ter sido aplicada e o índice por linha
+ *         é desligado.
+ * @return 2 se algum índice estiver fora dos limites (a matriz não é alterada).
+ */
+int matrix_setelem_batch(Matrix *m, const int *is, const int *js, const float *vals, int k) {
+    if (k > 0 && !vals) return 1;
+
+    LoteOrdenado l;
+    int erro = lote_ordena(m, is, js, vals, k, &l);
+    if (erro) return erro;
+
+    for (int i = 0; i < m->linhas && !erro; i++) {
+        erro = matrix_setelem_batch_row(m, &l, i, &m->pool);
+    }
+    if (erro) matrix_index_disable(m);
+
+    lote_free(&l);
+    return erro;
+}
+
+/**
+ * @brief Consulta um lote de posições (i, j) da matriz.
+ *
+ * Ordena as posições por (linha, coluna) e percorre cada linha uma única vez.
+ * O resultado sai na ordem original do lote.
+ *
+ * @param m Ponteiro constante para a matriz.
+ * @param is Índices de linha (base 1).
+ * @param js Índices de coluna (base 1).
+ * @param k Número de posições.
+ * @param out Vetor com k posições; out[t] recebe o valor de (is[t], js[t]) ou 0.0.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se falhar alguma alocação.
+ * @return 2 se algum índice estiver fora dos limites.
+ */
+int matrix_getelem_batch(const Matrix *m, const int *is, const int *js, int k, float *out) {
+    if (k > 0 && !out) return 1;
+
+    LoteOrdenado l;
+    int erro = lote_ordena(m, is, js, NULL, k, &l);
+    if (erro) return erro;
+
+    for (int i = 0; i < m->linhas; i++) {
+        POINT p = m->mat[i];
+        for (int t = l.inicio[i]; t < l.inicio[i + 1]; t++) {
+            int j = js[l.perm[t]];
+            while (p && p->coluna < j) p = p->prox;
+            out[l.perm[t]] = (p && p->coluna == j) ? p->valor : 0.0f;
+        }
+    }
+
+    lote_free(&l);
+    return 0;
+}
@@ -0,0 +1,238 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "binary.h"
+#include "csr.h"
+
+/* Alinhamento de cada seção no arquivo (uma linha de cache). */
+#define BINARY_ALINHAMENTO 64
+
+static const char BINARY_MAGICA[8] = {'S', 'P', 'M', 'C', 'S', 'R', '\0', '\0'};
+
+/*
+ * Cabeçalho do arquivo (64 bytes). As seções row_ptr (linhas + 1 int32),
+ * col_idx (nnz int32) e values (nnz float32) começam nos deslocamentos
+ * indicados, alinhados a BINARY_ALINHAMENTO, e usam a ordem de bytes da
+ * máquina que gravou (verificada pelo campo `endian`).
+ */
+typedef struct CabecalhoBinario {
+    char magica[8];
+    uint32_t versao;
+    uint32_t endian;
+    int32_t linhas;
+    int32_t colunas;
+    int64_t nnz;
+    uint64_t off_row_ptr;
+    uint64_t off_col_idx;
+    uint64_t off_values;
+    uint64_t tamanho;
+} CabecalhoBinario;
+
+static uint64_t alinha(uint64_t x) {
+    return (x + BINARY_ALINHAMENTO - 1) & ~(uint64_t)(BINARY_ALINHAMENTO - 1);
+}
+
+/* A seção [off, off + bytes) cabe em `tamanho` bytes? (sem estourar uint64_t) */
+static int secao_cabe(uint64_t off, uint64_t bytes, uint64_t tamanho) {
+    return off <= tamanho && bytes <= tamanho - off;
+}
+
+static int grava_secao(FILE *f, uint64_t *pos, uint64_t off, const void *dados, size_t bytes) {
+    static const char zeros[BINARY_ALINHAMENTO] = {0};
+
+    if (off > *pos && fwrite(zeros, 1, (size_t)(off - *pos), f) != off - *pos) return 1;
+    if (bytes && fwrite(dados, 1, bytes, f) != bytes) return 1;
+    *pos = off + bytes;
+    return 0;
+}
+
+/**
+ * @brief Grava uma matriz CSR no formato binário versionado.
+ *
+ * O arquivo tem um cabeçalho de 64 bytes seguido das seções row_ptr, col_idx e
+ * values, cada uma alinhada a 64 bytes, prontas para uso direto depois de
+ * mapeadas por `csr_map_binary`.
+ *
+ * @param caminho Caminho do arquivo de saída (sobrescrito se existir).
+ * @param c Ponteiro constante para a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se ocorrer erro de escrita.
+ */
+int csr_save_binary(const char *caminho, const MatrixCSR *c) {
+    if (!caminho || !c) return 1;
+
+    CabecalhoBinario h;
+    memset(&h, 0, sizeof h);
+    memcpy(h.magica, BINARY_MAGICA, sizeof h.magica);
+    h.versao = BINARY_VERSAO;
+    h.endian = 0x01020304u;
+    h.linhas = c->linhas;
+    h.colunas = c->colunas;
+    h.nnz = c->nnz;
+
+    size_t b_row = ((size_t)c->linhas + 1) * sizeof(int32_t);
+    size_t b_col = (size_t)c->nnz * sizeof(int32_t);
+    size_t b_val = (size_t)c->nnz * sizeof(float);
+
+    h.off_row_ptr = alinha(sizeof h);
+    h.off_col_idx = alinha(h.off_row_ptr + b_row);
+    h.off_values = alinha(h.off_col_idx + b_col);
+    h.tamanho = h.off_values + b_val;
+
+    FILE *f = fopen(caminho, "wb");
+    if (!f) return 1;
+
+    uint64_t pos = 0;
+    int erro = grava_secao(f, &pos, 0, &h, sizeof h) ||
+               grava_secao(f, &pos, h.off_row_ptr, c->row_ptr, b_row) ||
+               grava_secao(f, &pos, h.off_col_idx, c->col_idx, b_col) ||
+               grava_secao(f, &pos, h.off_values, c->values, b_val);
+
+    if (fclose(f) != 0) erro = 1;
+    return erro;
+}
+
+/**
+ * @brief Grava uma matriz em listas encadeadas no formato binário.
+ *
+ * Converte para CSR com `csr_from_matrix` e grava com `csr_save_binary`.
+ *
+ * @param caminho Caminho do arquivo de saída.
+ * @param m Ponteiro constante para a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se falhar alguma alocação ou a escrita.
+ */
+int matrix_save_binary(const char *caminho, const Matrix *m) {
+    MatrixCSR *c = NULL;
+    int erro = csr_from_matrix(m, &c);
+    if (erro) return erro;
+
+    erro = csr_save_binary(caminho, c);
+    csr_destroy(c);
+    return erro;
+}
+
+/**
+ * @brief Mapeia em memória um arquivo gravado por `csr_save_binary`.
+ *
+ * Os vetores da matriz retornada apontam diretamente para o arquivo mapeado
+ * (somente leitura), sem cópia: a carga custa apenas a validação do cabeçalho,
+ * de `row_ptr` e das colunas de `col_idx` (dentro dos limites e crescentes em
+ * cada linha), uma passada O(linhas + nnz). A matriz pode ser usada por
+ * `csr_getelem`, `csr_add`, `csr_multiply`, `csr_transpose` e demais funções
+ * que recebem `const MatrixCSR*`, mas não pode ser modificada. Libere com `csr_destroy`.
+ *
+ * @param caminho Caminho do arquivo.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se o arquivo não puder ser aberto/mapeado
+ *         ou se falhar alguma alocação.
+ * @return 2 se o arquivo não for um formato binário válido desta versão e arquitetura.
+ *
+ * @post Em sucesso, `*r` aponta para a matriz mapeada; em erro, `*r` permanece NULL.
+ */
+int csr_map_binary(const char *caminho, MatrixCSR **r) {
+    if (!caminho || !r) return 1;
+    *r = NULL;
+    if (sizeof(int) != sizeof(int32_t)) return 2;
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return 1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 1;
+    }
+    if ((uint64_t)st.st_size < sizeof(CabecalhoBinario)) {
+        close(fd);
+        return 2;
+    }
+
+    void *mapa = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) return 1;
+
+    const CabecalhoBinario *h = (const CabecalhoBinario*)mapa;
+    const char *base = (const char*)mapa;
+    int erro = 0;
+
+    if (memcmp(h->magica, BINARY_MAGICA, sizeof h->magica) != 0 ||
+        h->versao != BINARY_VERSAO || h->endian != 0x01020304u ||
+        h->linhas <= 0 || h->colunas <= 0 || h->nnz < 0 || h->nnz > 0x7fffffff ||
+        h->tamanho > (uint64_t)st.st_size ||
+        h->off_row_ptr % BINARY_ALINHAMENTO || h->off_col_idx % BINARY_ALINHAMENTO ||
+        h->off_values % BINARY_ALINHAMENTO ||
+        !secao_cabe(h->off_row_ptr, ((uint64_t)h->linhas + 1) * 4, h->tamanho) ||
+        !secao_cabe(h->off_col_idx, (uint64_t)h->nnz * 4, h->tamanho) ||
+        !secao_cabe(h->off_values, (uint64_t)h->nnz * 4, h->tamanho)) {
+        erro = 2;
+    }
+
+    /* row_ptr não decrescente e colunas de cada linha em [0, colunas), estritamente crescentes */
+    const int *row_ptr = erro ? NULL : (const int*)(base + h->off_row_ptr);
+    const int *col_idx = erro ? NULL : (const int*)(base + h->off_col_idx);
+    if (!erro && (row_ptr[0] != 0 || row_ptr[h->linhas] != h->nnz)) erro = 2;
+    for (int i = 0; !erro && i < h->linhas; i++) {
+        if (row_ptr[i] > row_ptr[i + 1]) {
+            erro = 2;
+            break;
+        }
+        int anterior = -1;
+        for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            if (col_idx[k] <= anterior || col_idx[k] >= h->colunas) {
+                erro = 2;
+                break;
+            }
+            anterior = col_idx[k];
+        }
+    }
+
+    MatrixCSR *c = erro ? NULL : (MatrixCSR*)malloc(sizeof(MatrixCSR));
+    if (!erro && !c) erro = 1;
+
+    if (erro) {
+        munmap(mapa, (size_t)st.st_size);
+        return erro;
+    }
+
+    c->linhas = h->linhas;
+    c->colunas = h->colunas;
+    c->nnz = (int)h->nnz;
+    c->row_ptr = (int*)(base + h->off_row_ptr);
+    c->col_idx = (int*)(base + h->off_col_idx);
+    c->values = (float*)(base + h->off_values);
+    c->mapa = mapa;
+    c->mapa_tam = (size_t)st.st_size;
+
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Desfaz o mapeamento de uma matriz obtida por `csr_map_binary`.
+ *
+ * Normalmente chamada por `csr_destroy`.
+ *
+ * @param c Ponteiro para a matriz mapeada.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c` for NULL, se não estiver mapeada ou se munmap falhar.
+ */
+int csr_unmap_binary(MatrixCSR *c) {
+    if (!c || !c->mapa) return 1;
+
+    int erro = munmap(c->mapa, c->mapa_tam) != 0;
+    free(c);
+    return erro;
+}
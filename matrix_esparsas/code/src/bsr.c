@@ -0,0 +1,568 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bsr.h"
+#include "create.h"
+#include "pool.h"
+#include "simd.h"
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+#define BB (BSR_BLOCO * BSR_BLOCO)
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Kernels de bloco: laços com trip count constante (BSR_BLOCO), sobre blocos
+ * guardados em ordem de coluna, que o compilador vetoriza por inteiro.
+ */
+
+static void bloco_soma(const float *a, const float *b, float *r) {
+    for (int t = 0; t < BB; t++) r[t] = a[t] + b[t];
+}
+
+static int bloco_nulo(const float *v) {
+    for (int t = 0; t < BB; t++) {
+        if (v[t] != 0.0f) return 0;
+    }
+    return 1;
+}
+
+/* c += a * b; a coluna cc de c é uma combinação das colunas de a. */
+static void bloco_multiplica_acumula(const float *a, const float *b, float *c) {
+    for (int cc = 0; cc < BSR_BLOCO; cc++) {
+        for (int kk = 0; kk < BSR_BLOCO; kk++) {
+            float bkc = b[cc * BSR_BLOCO + kk];
+            for (int r = 0; r < BSR_BLOCO; r++) c[cc * BSR_BLOCO + r] += a[kk * BSR_BLOCO + r] * bkc;
+        }
+    }
+}
+
+/*
+ * Trecho de x que multiplica a coluna de blocos bj. Na última coluna de
+ * blocos, se `colunas` não for múltiplo de BSR_BLOCO, copia para `tmp`
+ * completando com zeros, para não ler além do fim de x.
+ */
+static const float* trecho_x(const MatrixBSR *a, const float *x, int bj, float *tmp) {
+    int j0 = bj * BSR_BLOCO;
+    if (j0 + BSR_BLOCO <= a->colunas) return x + j0;
+
+    for (int c = 0; c < BSR_BLOCO; c++) tmp[c] = (j0 + c < a->colunas) ? x[j0 + c] : 0.0f;
+    return tmp;
+}
+
+/* Grava as linhas válidas da linha de blocos bi em y. */
+static void grava_y(const MatrixBSR *a, int bi, const float *acc, float *y) {
+    int i0 = bi * BSR_BLOCO;
+    for (int r = 0; r < BSR_BLOCO && i0 + r < a->linhas; r++) y[i0 + r] = acc[r];
+}
+
+static void spmv_bsr_escalar(const MatrixBSR *a, const float *x, float *y) {
+    float tmp[BSR_BLOCO];
+    for (int bi = 0; bi < a->blinhas; bi++) {
+        float acc[BSR_BLOCO] = {0.0f};
+        for (int k = a->row_ptr[bi]; k < a->row_ptr[bi + 1]; k++) {
+            const float *v = a->values + (size_t)k * BB;
+            const float *xb = trecho_x(a, x, a->col_idx[k], tmp);
+            for (int c = 0; c < BSR_BLOCO; c++) {
+                for (int r = 0; r < BSR_BLOCO; r++) acc[r] += v[c * BSR_BLOCO + r] * xb[c];
+            }
+        }
+        grava_y(a, bi, acc, y);
+    }
+}
+
+#if SIMD_X86 && BSR_BLOCO == 4
+/*
+ * Blocos 4 x 4: cada registrador de 256 bits leva duas colunas do bloco, e x
+ * é replicado por coluna com permutação ([x0 x0 x0 x0 x1 x1 x1 x1]).
+ */
+__attribute__((target("avx2,fma")))
+static void spmv_bsr_avx2(const MatrixBSR *a, const float *x, float *y) {
+    const __m256i idx01 = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    const __m256i idx23 = _mm256_setr_epi32(2, 2, 2, 2, 3, 3, 3, 3);
+    float tmp[4], acc[4];
+
+    for (int bi = 0; bi < a->blinhas; bi++) {
+        __m256 s = _mm256_setzero_ps();
+        for (int k = a->row_ptr[bi]; k < a->row_ptr[bi + 1]; k++) {
+            const float *v = a->values + (size_t)k * 16;
+            __m256 xb = _mm256_castps128_ps256(_mm_loadu_ps(trecho_x(a, x, a->col_idx[k], tmp)));
+            s = _mm256_fmadd_ps(_mm256_loadu_ps(v), _mm256_permutevar8x32_ps(xb, idx01), s);
+            s = _mm256_fmadd_ps(_mm256_loadu_ps(v + 8), _mm256_permutevar8x32_ps(xb, idx23), s);
+        }
+        _mm_storeu_ps(acc, _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1)));
+        grava_y(a, bi, acc, y);
+    }
+}
+
+/* Blocos 4 x 4: o bloco inteiro cabe em um registrador de 512 bits. */
+__attribute__((target("avx512f")))
+static void spmv_bsr_avx512(const MatrixBSR *a, const float *x, float *y) {
+    const __m512i idx = _mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    float tmp[4], acc[4];
+
+    for (int bi = 0; bi < a->blinhas; bi++) {
+        __m512 s = _mm512_setzero_ps();
+        for (int k = a->row_ptr[bi]; k < a->row_ptr[bi + 1]; k++) {
+            __m512 xb = _mm512_castps128_ps512(_mm_loadu_ps(trecho_x(a, x, a->col_idx[k], tmp)));
+            s = _mm512_fmadd_ps(_mm512_loadu_ps(a->values + (size_t)k * 16), _mm512_permutexvar_ps(idx, xb), s);
+        }
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm512_extractf32x4_ps(s, 0), _mm512_extractf32x4_ps(s, 1)),
+                              _mm_add_ps(_mm512_extractf32x4_ps(s, 2), _mm512_extractf32x4_ps(s, 3)));
+        _mm_storeu_ps(acc, r);
+        grava_y(a, bi, acc, y);
+    }
+}
+#endif
+
+/**
+ * @brief Inicializa uma matriz BSR vazia com capacidade para `nnzb` blocos.
+ *
+ * Aloca `row_ptr` (blinhas + 1 posições, zeradas), `col_idx` com `nnzb`
+ * posições e `values` com `nnzb` blocos zerados, alinhado a 64 bytes.
+ * Cabe ao chamador preencher os vetores.
+ *
+ * @param linhas Número de linhas (> 0), em elementos.
+ * @param colunas Número de colunas (> 0), em elementos.
+ * @param nnzb Número de blocos armazenados (>= 0).
+ *
+ * @return Ponteiro para a matriz alocada em caso de sucesso.
+ * @return NULL se os parâmetros forem inválidos ou se falhar alguma alocação.
+ *
+ * @post c->row_ptr[bi] == 0 para todo bi; c->nnzb == nnzb.
+ */
+MatrixBSR* bsr_init(int linhas, int colunas, int nnzb) {
+    if (linhas <= 0 || colunas <= 0 || nnzb < 0) return NULL;
+
+    MatrixBSR *c = (MatrixBSR*)malloc(sizeof(MatrixBSR));
+    if (!c) return NULL;
+
+    size_t bytes = (nnzb ? (size_t)nnzb : 1) * BB * sizeof(float);
+    bytes = (bytes + 63) & ~(size_t)63;
+
+    c->linhas = linhas;
+    c->colunas = colunas;
+    c->blinhas = (linhas + BSR_BLOCO - 1) / BSR_BLOCO;
+    c->bcolunas = (colunas + BSR_BLOCO - 1) / BSR_BLOCO;
+    c->nnzb = nnzb;
+    c->row_ptr = (int*)calloc((size_t)c->blinhas + 1, sizeof(int));
+    c->col_idx = (int*)malloc((nnzb ? (size_t)nnzb : 1) * sizeof(int));
+    c->values = (float*)aligned_alloc(64, bytes);
+
+    if (!c->row_ptr || !c->col_idx || !c->values) {
+        bsr_destroy(c);
+        return NULL;
+    }
+    memset(c->values, 0, bytes);
+    return c;
+}
+
+/**
+ * @brief Libera toda a memória associada a uma matriz BSR.
+ *
+ * @param c Ponteiro para a matriz a ser destruída.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c` for NULL.
+ */
+int bsr_destroy(MatrixBSR *c) {
+    if (!c) return 1;
+
+    free(c->row_ptr);
+    free(c->col_idx);
+    free(c->values);
+    free(c);
+    return 0;
+}
+
+/*
+ * Colunas de blocos tocadas pelas linhas da linha de blocos bi, sem repetição
+ * e em ordem arbitrária. `marca` deve valer != bi para todas as colunas.
+ */
+static int blocos_da_linha(const Matrix *m, int bi, int *marca, int *tocadas) {
+    int ntoc = 0;
+    for (int r = 0; r < BSR_BLOCO; r++) {
+        int i = bi * BSR_BLOCO + r;
+        if (i >= m->linhas) break;
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            int bj = (p->coluna - 1) / BSR_BLOCO;
+            if (marca[bj] != bi) {
+                marca[bj] = bi;
+                tocadas[ntoc++] = bj;
+            }
+        }
+    }
+    return ntoc;
+}
+
+/**
+ * @brief Converte uma matriz em listas encadeadas para o formato BSR.
+ *
+ * Uma passada conta os blocos distintos de cada linha de blocos; a segunda
+ * ordena as colunas de blocos e espalha os elementos nos blocos. Posições de
+ * um bloco sem elemento correspondente ficam com 0.0.
+ *
+ * @param m Ponteiro constante para a matriz de origem.
+ * @param r Endereço de ponteiro que receberá a matriz BSR.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m`/`r` forem NULL, se o número de blocos passar de INT_MAX
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz BSR; em erro, `*r` permanece NULL.
+ */
+int bsr_from_matrix(const Matrix *m, MatrixBSR **r) {
+    if (!m || !m->mat || !r) return 1;
+    *r = NULL;
+
+    int bl = (m->linhas + BSR_BLOCO - 1) / BSR_BLOCO;
+    int bc = (m->colunas + BSR_BLOCO - 1) / BSR_BLOCO;
+    int *marca = (int*)malloc((size_t)bc * sizeof(int));
+    int *tocadas = (int*)malloc((size_t)bc * sizeof(int));
+    int *pos = (int*)malloc((size_t)bc * sizeof(int));
+    if (!marca || !tocadas || !pos) {
+        free(marca);
+        free(tocadas);
+        free(pos);
+        return 1;
+    }
+
+    long long total = 0;
+    for (int j = 0; j < bc; j++) marca[j] = -1;
+    for (int bi = 0; bi < bl; bi++) total += blocos_da_linha(m, bi, marca, tocadas);
+
+    MatrixBSR *c = (total > 0x7fffffff) ? NULL : bsr_init(m->linhas, m->colunas, (int)total);
+    if (!c) {
+        free(marca);
+        free(tocadas);
+        free(pos);
+        return 1;
+    }
+
+    int k = 0;
+    for (int j = 0; j < bc; j++) marca[j] = -1;
+    for (int bi = 0; bi < bl; bi++) {
+        int ntoc = blocos_da_linha(m, bi, marca, tocadas);
+        qsort(tocadas, (size_t)ntoc, sizeof(int), cmp_int);
+
+        c->row_ptr[bi] = k;
+        for (int u = 0; u < ntoc; u++) {
+            c->col_idx[k + u] = tocadas[u];
+            pos[tocadas[u]] = k + u;
+        }
+
+        for (int rr = 0; rr < BSR_BLOCO; rr++) {
+            int i = bi * BSR_BLOCO + rr;
+            if (i >= m->linhas) break;
+            for (POINT p = m->mat[i]; p; p = p->prox) {
+                int j = p->coluna - 1;
+                float *blk = c->values + (size_t)pos[j / BSR_BLOCO] * BB;
+                blk[(j % BSR_BLOCO) * BSR_BLOCO + rr] = p->valor;
+            }
+        }
+        k += ntoc;
+    }
+    c->row_ptr[bl] = k;
+
+    free(marca);
+    free(tocadas);
+    free(pos);
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Converte uma matriz BSR para a representação em listas encadeadas.
+ *
+ * Os zeros de dentro dos blocos (e o preenchimento da borda) não viram nós.
+ *
+ * @param c Ponteiro constante para a matriz BSR de origem.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int bsr_to_matrix(const MatrixBSR *c, Matrix **r) {
+    if (!c || !r) return 1;
+    *r = NULL;
+
+    Matrix *res = init_matrix(c->linhas, c->colunas);
+    if (!res) return 1;
+
+    int nnz = 0;
+    for (size_t t = 0; t < (size_t)c->nnzb * BB; t++) nnz += c->values[t] != 0.0f;
+    if (pool_reserve(&res->pool, nnz)) {
+        matrix_destroy(res);
+        return 1;
+    }
+
+    for (int i = 0; i < c->linhas; i++) {
+        int bi = i / BSR_BLOCO;
+        int rr = i % BSR_BLOCO;
+        POINT *cauda = &res->mat[i];
+
+        for (int k = c->row_ptr[bi]; k < c->row_ptr[bi + 1]; k++) {
+            const float *blk = c->values + (size_t)k * BB;
+            for (int cc = 0; cc < BSR_BLOCO; cc++) {
+                int j = c->col_idx[k] * BSR_BLOCO + cc;
+                float v = blk[cc * BSR_BLOCO + rr];
+                if (j >= c->colunas || v == 0.0f) continue;
+
+                No *novo = pool_alloc(&res->pool);
+                if (!novo) {
+                    matrix_destroy(res);
+                    return 1;
+                }
+                novo->coluna = j + 1;
+                novo->valor = v;
+                novo->prox = NULL;
+
+                *cauda = novo;
+                cauda = &novo->prox;
+            }
+        }
+    }
+
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Obtém o valor de um elemento da matriz BSR.
+ *
+ * Faz busca binária nas colunas de blocos da linha de blocos de x.
+ * As posições x e y seguem indexação iniciando em 1, como em `matrix_getelem`.
+ *
+ * @param c Ponteiro constante para a matriz BSR.
+ * @param x Índice da linha (1 ≤ x ≤ c->linhas).
+ * @param y Índice da coluna (1 ≤ y ≤ c->colunas).
+ * @param elem Ponteiro para armazenar o valor do elemento encontrado.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c`/`elem` forem NULL ou se os índices estiverem fora dos limites.
+ *
+ * @post `*elem` contém o valor do elemento (x, y) ou 0.0 se o bloco não estiver armazenado.
+ */
+int bsr_getelem(const MatrixBSR *c, int x, int y, float *elem) {
+    if (!c || !elem) return 1;
+    if (x < 1 || x > c->linhas) return 1;
+    if (y < 1 || y > c->colunas) return 1;
+
+    int bi = (x - 1) / BSR_BLOCO;
+    int alvo = (y - 1) / BSR_BLOCO;
+    int ini = c->row_ptr[bi];
+    int fim = c->row_ptr[bi + 1];
+
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (c->col_idx[meio] < alvo) ini = meio + 1;
+        else fim = meio;
+    }
+
+    if (ini < c->row_ptr[bi + 1] && c->col_idx[ini] == alvo) {
+        *elem = c->values[(size_t)ini * BB + ((y - 1) % BSR_BLOCO) * BSR_BLOCO + (x - 1) % BSR_BLOCO];
+    } else {
+        *elem = 0.0f;
+    }
+    return 0;
+}
+
+/**
+ * @brief Calcula a soma de duas matrizes BSR de mesmas dimensões.
+ *
+ * Intercala as linhas de blocos de `a` e `b` em uma única passada; blocos
+ * presentes nas duas são somados inteiros. Blocos que resultarem todos nulos
+ * não são armazenados.
+ *
+ * @param a Ponteiro constante para a primeira matriz.
+ * @param b Ponteiro constante para a segunda matriz.
+ * @param r Endereço de ponteiro que receberá a matriz resultante.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz BSR; em erro, `*r` permanece NULL.
+ */
+int bsr_add(const MatrixBSR *a, const MatrixBSR *b, MatrixBSR **r) {
+    if (!a || !b || !r) return 1;
+    *r = NULL;
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 1;
+
+    long long total = (long long)a->nnzb + b->nnzb;
+    MatrixBSR *c = (total > 0x7fffffff) ? NULL : bsr_init(a->linhas, a->colunas, (int)total);
+    if (!c) return 1;
+
+    int k = 0;
+    for (int bi = 0; bi < a->blinhas; bi++) {
+        int pa = a->row_ptr[bi], fa = a->row_ptr[bi + 1];
+        int pb = b->row_ptr[bi], fb = b->row_ptr[bi + 1];
+
+        c->row_ptr[bi] = k;
+        while (pa < fa || pb < fb) {
+            float *dst = c->values + (size_t)k * BB;
+
+            if (pb >= fb || (pa < fa && a->col_idx[pa] < b->col_idx[pb])) {
+                c->col_idx[k] = a->col_idx[pa];
+                memcpy(dst, a->values + (size_t)pa++ * BB, BB * sizeof(float));
+            } else if (pa >= fa || b->col_idx[pb] < a->col_idx[pa]) {
+                c->col_idx[k] = b->col_idx[pb];
+                memcpy(dst, b->values + (size_t)pb++ * BB, BB * sizeof(float));
+            } else {
+                c->col_idx[k] = a->col_idx[pa];
+                bloco_soma(a->values + (size_t)pa++ * BB, b->values + (size_t)pb++ * BB, dst);
+            }
+
+            if (!bloco_nulo(dst)) k++;
+        }
+    }
+    c->row_ptr[a->blinhas] = k;
+    c->nnzb = k;
+
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Calcula o produto de duas matrizes BSR (Gustavson sobre blocos).
+ *
+ * Uma passada simbólica conta as colunas de blocos distintas de cada linha de
+ * blocos do produto. Na passada numérica, cada par de blocos A(bi, bk) e
+ * B(bk, bj) é multiplicado (produto denso BSR_BLOCO x BSR_BLOCO) e acumulado
+ * em um vetor denso de blocos; as colunas tocadas são ordenadas e os blocos
+ * gravados, descartando os que resultarem todos nulos. As somas são feitas em
+ * float, então o resultado pode diferir de `matrix_multiply` no último bit.
+ *
+ * @param a Ponteiro constante para a matriz à esquerda (m x p).
+ * @param b Ponteiro constante para a matriz à direita (p x q).
+ * @param r Endereço de ponteiro que receberá o produto (m x q).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a->colunas != b->linhas
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz BSR; em erro, `*r` permanece NULL.
+ */
+int bsr_multiply(const MatrixBSR *a, const MatrixBSR *b, MatrixBSR **r) {
+    if (!a || !b || !r) return 1;
+    *r = NULL;
+    if (a->colunas != b->linhas) return 1;
+
+    int q = b->bcolunas;
+    int *marca = (int*)malloc((size_t)q * sizeof(int));
+    float *acc = (float*)malloc((size_t)q * BB * sizeof(float));
+    if (!marca || !acc) {
+        free(marca);
+        free(acc);
+        return 1;
+    }
+    for (int j = 0; j < q; j++) marca[j] = -1;
+
+    /* passada simbólica: limite superior de blocos por linha de blocos */
+    long long total = 0;
+    for (int bi = 0; bi < a->blinhas; bi++) {
+        for (int ka = a->row_ptr[bi]; ka < a->row_ptr[bi + 1]; ka++) {
+            int bk = a->col_idx[ka];
+            for (int kb = b->row_ptr[bk]; kb < b->row_ptr[bk + 1]; kb++) {
+                int bj = b->col_idx[kb];
+                if (marca[bj] != bi) {
+                    marca[bj] = bi;
+                    total++;
+                }
+            }
+        }
+    }
+
+    MatrixBSR *c = (total > 0x7fffffff) ? NULL : bsr_init(a->linhas, b->colunas, (int)total);
+    if (!c) {
+        free(marca);
+        free(acc);
+        return 1;
+    }
+    for (int j = 0; j < q; j++) marca[j] = -1;
+
+    /* passada numérica */
+    int k_out = 0;
+    for (int bi = 0; bi < a->blinhas; bi++) {
+        int ini = k_out;
+        c->row_ptr[bi] = ini;
+
+        for (int ka = a->row_ptr[bi]; ka < a->row_ptr[bi + 1]; ka++) {
+            int bk = a->col_idx[ka];
+            const float *va = a->values + (size_t)ka * BB;
+            for (int kb = b->row_ptr[bk]; kb < b->row_ptr[bk + 1]; kb++) {
+                int bj = b->col_idx[kb];
+                float *dst = acc + (size_t)bj * BB;
+                if (marca[bj] != bi) {
+                    marca[bj] = bi;
+                    c->col_idx[k_out++] = bj;
+                    memset(dst, 0, BB * sizeof(float));
+                }
+                bloco_multiplica_acumula(va, b->values + (size_t)kb * BB, dst);
+            }
+        }
+
+        qsort(c->col_idx + ini, (size_t)(k_out - ini), sizeof(int), cmp_int);
+
+        int w = ini;
+        for (int t = ini; t < k_out; t++) {
+            int bj = c->col_idx[t];
+            const float *src = acc + (size_t)bj * BB;
+            if (bloco_nulo(src)) continue;
+            c->col_idx[w] = bj;
+            memcpy(c->values + (size_t)w * BB, src, BB * sizeof(float));
+            w++;
+        }
+        k_out = w;
+    }
+    c->row_ptr[a->blinhas] = k_out;
+    c->nnzb = k_out;
+
+    free(marca);
+    free(acc);
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Produto matriz-vetor y = A * x no formato BSR.
+ *
+ * Cada bloco é multiplicado pelo trecho correspondente de x, sem leitura de
+ * índice por elemento. Com BSR_BLOCO == 4, escolhe em tempo de execução o
+ * kernel AVX-512 (um bloco por registrador), AVX2 (meio bloco por
+ * registrador) ou escalar, conforme `simd_nivel()`; com outros tamanhos usa o
+ * kernel escalar, cujos laços de tamanho fixo o compilador vetoriza.
+ *
+ * @param a Ponteiro constante para a matriz BSR (linhas x colunas).
+ * @param x Vetor denso com a->colunas posições.
+ * @param y Vetor denso com a->linhas posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int bsr_spmv(const MatrixBSR *a, const float *x, float *y) {
+    if (!a || !x || !y) return 1;
+
+#if SIMD_X86 && BSR_BLOCO == 4
+    switch (simd_nivel()) {
+        case SIMD_AVX512:
+            spmv_bsr_avx512(a, x, y);
+            return 0;
+        case SIMD_AVX2:
+            spmv_bsr_avx2(a, x, y);
+            return 0;
+        default:
+            break;
+    }
+#endif
+    spmv_bsr_escalar(a, x, y);
+    return 0;
+}
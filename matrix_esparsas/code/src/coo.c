@@ -0,0 +1,176 @@
+#include <stdlib.h>
+#include "coo.h"
+#include "csr.h"
+
+/**
+ * @brief Ordena triplas (i, j) por linha e coluna com radix sort LSD.
+ *
+ * Faz uma ordenação por contagem pela coluna seguida de uma ordenação por
+ * contagem estável pela linha; o resultado fica ordenado por (i, j) e
+ * elementos repetidos mantêm a ordem em que aparecem na entrada.
+ * Custo O(nnz + linhas + colunas).
+ *
+ * Índices seguem indexação iniciando em 1.
+ *
+ * @param linhas Número de linhas.
+ * @param colunas Número de colunas.
+ * @param is Vetor de índices de linha.
+ * @param js Vetor de índices de coluna.
+ * @param nnz Número de triplas.
+ * @param perm Vetor com nnz posições; recebe a permutação ordenada
+ *             (perm[k] é a posição na entrada do k-ésimo elemento).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se falhar alguma alocação.
+ * @return 2 se algum índice estiver fora dos limites.
+ */
+int coo_sort_perm(int linhas, int colunas, const int *is, const int *js, int nnz, int *perm) {
+    if (nnz < 0 || (nnz > 0 && (!is || !js || !perm))) return 1;
+
+    for (int k = 0; k < nnz; k++) {
+        if (is[k] < 1 || is[k] > linhas) return 2;
+        if (js[k] < 1 || js[k] > colunas) return 2;
+    }
+
+    int maior = linhas > colunas ? linhas : colunas;
+    int *cont = (int*)malloc(((size_t)maior + 1) * sizeof(int));
+    int *aux = (int*)malloc((nnz ? (size_t)nnz : 1) * sizeof(int));
+    if (!cont || !aux) {
+        free(cont);
+        free(aux);
+        return 1;
+    }
+
+    /* passada 1: por coluna */
+    for (int j = 0; j <= colunas; j++) cont[j] = 0;
+    for (int k = 0; k < nnz; k++) cont[js[k]]++;
+    for (int j = 1, soma = 0; j <= colunas; j++) {
+        int c = cont[j];
+        cont[j] = soma;
+        soma += c;
+    }
+    for (int k = 0; k < nnz; k++) aux[cont[js[k]]++] = k;
+
+    /* passada 2: por linha, estável */
+    for (int i = 0; i <= linhas; i++) cont[i] = 0;
+    for (int k = 0; k < nnz; k++) cont[is[k]]++;
+    for (int i = 1, soma = 0; i <= linhas; i++) {
+        int c = cont[i];
+        cont[i] = soma;
+        soma += c;
+    }
+    for (int t = 0; t < nnz; t++) {
+        int k = aux[t];
+        perm[cont[is[k]]++] = k;
+    }
+
+    free(cont);
+    free(aux);
+    return 0;
+}
+
+/**
+ * @brief Monta uma matriz CSR a partir de triplas (i, j, valor).
+ *
+ * As triplas podem estar fora de ordem e conter repetições: são ordenadas
+ * por `coo_sort_perm`, os valores de uma mesma posição são somados e as
+ * somas iguais a 0.0 são descartadas.
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ * @param is Índices de linha (base 1).
+ * @param js Índices de coluna (base 1).
+ * @param vals Valores.
+ * @param nnz Número de triplas.
+ * @param r Endereço de ponteiro que receberá a matriz CSR.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem inválidas ou se falhar alguma alocação.
+ * @return 2 se algum índice estiver fora dos limites.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int csr_from_coo(int linhas, int colunas, const int *is, const int *js,
+                 const float *vals, int nnz, MatrixCSR **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (nnz > 0 && !vals) return 1;
+
+    MatrixCSR *c = csr_init(linhas, colunas, nnz);
+    if (!c) return 1;
+
+    int *perm = (int*)malloc((nnz ? (size_t)nnz : 1) * sizeof(int));
+    if (!perm) {
+        csr_destroy(c);
+        return 1;
+    }
+
+    int erro = coo_sort_perm(linhas, colunas, is, js, nnz, perm);
+    if (erro) {
+        free(perm);
+        csr_destroy(c);
+        return erro;
+    }
+
+    int w = 0;
+    int t = 0;
+    for (int i = 1; i <= linhas; i++) {
+        c->row_ptr[i - 1] = w;
+
+        while (t < nnz && is[perm[t]] == i) {
+            int j = js[perm[t]];
+            double soma = 0.0;
+            while (t < nnz && is[perm[t]] == i && js[perm[t]] == j) {
+                soma += vals[perm[t]];
+                t++;
+            }
+            if ((float)soma != 0.0f) {
+                c->col_idx[w] = j - 1;
+                c->values[w] = (float)soma;
+                w++;
+            }
+        }
+    }
+    c->row_ptr[linhas] = w;
+    c->nnz = w;
+
+    free(perm);
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Monta uma matriz em listas encadeadas a partir de triplas (i, j, valor).
+ *
+ * Equivale a várias chamadas de `matrix_setelem`, mas ordena as triplas de uma
+ * vez (radix sort), soma as repetições e monta cada linha em uma única passada,
+ * com todos os nós reservados de uma vez. Diferente de `matrix_setelem`, triplas
+ * repetidas são somadas, e não sobrescritas.
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ * @param is Índices de linha (base 1).
+ * @param js Índices de coluna (base 1).
+ * @param vals Valores.
+ * @param nnz Número de triplas.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem inválidas ou se falhar alguma alocação.
+ * @return 2 se algum índice estiver fora dos limites.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_from_coo(int linhas, int colunas, const int *is, const int *js,
+                    const float *vals, int nnz, Matrix **r) {
+    if (!r) return 1;
+    *r = NULL;
+
+    MatrixCSR *c = NULL;
+    int erro = csr_from_coo(linhas, colunas, is, js, vals, nnz, &c);
+    if (erro) return erro;
+
+    erro = csr_to_matrix(c, r);
+    csr_destroy(c);
+    return erro;
+}
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include "create.h"
 #include "inputs.h"
+#include "pool.h"
+#include "indice.h"
+#include "instrument.h"
 #include <math.h>
 
 //helper
@@ -71,7 +74,8 @@ int insert_matrix_stdin(const char *label, Matrix *m) {
  * @brief Inicializa uma matriz esparsa vazia com dimensões (linhas x colunas).
  *
  * Aloca a estrutura `Matrix` e o vetor de ponteiros de linhas (`m->mat`),
- * inicializando cada posição com NULL (linhas vazias).
+ * inicializando cada posição com NULL (linhas vazias). O alocador de nós da
+ * matriz (`m->pool`) começa vazio.
  *
  * @param linhas Número de linhas (> 0).
  * @param colunas Número de colunas (> 0).
@@ -99,14 +103,17 @@ Matrix* init_matrix(int linhas, int colunas) {
     }
 
     for (int i = 0; i < linhas; i++) mat->mat[i] = NULL;
+    pool_init(&mat->pool);
+    mat->indice = NULL;
     return mat;
 }
 
 /**
  * @brief Libera toda a memória associada a uma matriz esparsa.
  *
- * Percorre cada linha da matriz, liberando todos os nós das listas encadeadas.
- * Em seguida libera o vetor `m->mat` e a própria estrutura `m`.
+ * Todos os nós das listas encadeadas pertencem ao alocador da matriz (`m->pool`),
+ * que é liberado slab a slab, sem percorrer as listas. Em seguida libera o
+ * índice por linha (se ligado), o vetor `m->mat` e a própria estrutura `m`.
  *
  * @param m Ponteiro para a matriz a ser destruída.
  *
@@ -119,18 +126,9 @@ Matrix* init_matrix(int linhas, int colunas) {
 int matrix_destroy(Matrix *m) {
     if (!m) return 1;
 
-    if (m->mat) {
-        for (int i = 0; i < m->linhas; i++) {
-            POINT atual = m->mat[i];
-            while (atual) {
-                POINT prox = atual->prox;
-                free(atual);
-                atual = prox;
-            }
-        }
-        free(m->mat);
-    }
-
+    matrix_index_disable(m);
+    pool_destroy(&m->pool);
+    free(m->mat);
     free(m);
     return 0;
 }
@@ -161,11 +159,29 @@ int matrix_destroy_labeled(const char *label, Matrix *m) {
     return matrix_destroy(m);
 }
 
+/* Corpo de `matrix_setelem` para uma linha (base 0) e coluna (base 1) já validadas. */
+static int setelem_linha(Matrix *m, int linha, int j, float valor) {
+    POINT anterior;
+    int pos;
+    POINT atual = linha_localiza(m, linha, j, &anterior, &pos);
+
+    if (atual && atual->coluna == j) {
+        if (valor == 0.0f) linha_remove(m, linha, anterior, atual, pos);
+        else atual->valor = valor;
+        return 0;
+    }
+
+    if (valor == 0.0f) return 0;
+
+    return linha_insere(m, linha, anterior, pos, j, valor);
+}
 
 /**
  * @brief Insere, atualiza ou remove um elemento (i, j) na matriz esparsa.
  *
- * Mantém a lista encadeada da linha i ordenada por coluna crescente.
+ * Mantém a lista encadeada da linha i ordenada por coluna crescente. Com o
+ * índice por linha ligado (`matrix_index_enable`), a posição é encontrada por
+ * busca binária e o índice é atualizado junto com a lista.
  * - Se já existe um nó na coluna j:
  *   - Se `valor == 0.0`, remove o nó.
  *   - Caso contrário, atualiza o valor do nó.
@@ -193,40 +209,17 @@ int matrix_setelem(Matrix *m, int i, int j, float valor) {
     if (i < 1 || i > m->linhas) return 1;
     if (j < 1 || j > m->colunas) return 1;
 
-    // Inicia-se com 1, conforme o enunciado
-    int linha = i - 1;
-    POINT anterior = NULL;
-    POINT atual = m->mat[linha];
+    INSTR_INICIO(t0);
+    INSTR_VAR(passos0, instr_passos_thread);
+    INSTR_VAR(alocados0, m->pool.alocados);
+    INSTR_VAR(liberados0, m->pool.liberados);
 
-    while (atual && atual->coluna < j) {
-        anterior = atual;
-        atual = atual->prox;
-    }
-
-    if (atual && atual->coluna == j) {
-        if (valor == 0.0f) {
-            if (anterior) anterior->prox = atual->prox;
-            else m->mat[linha] = atual->prox;
-            free(atual);
-        } else {
-            atual->valor = valor;
-        }
-        return 0;
-    }
-
-    if (valor == 0.0f) return 0;
-
-    No *novo = (No*)malloc(sizeof(No));
-    if (!novo) return 1;
-
-    novo->coluna = j;
-    novo->valor = valor;
-    novo->prox = atual;
-
-    if (anterior) anterior->prox = novo;
-    else m->mat[linha] = novo;
+    // Inicia-se com 1, conforme o enunciado
+    int erro = setelem_linha(m, i - 1, j, valor);
 
-    return 0;
+    INSTR_FIM(INSTR_SETELEM, t0, instr_passos_thread - passos0, 0, 0,
+              m->pool.alocados - alocados0, m->pool.liberados - liberados0);
+    return erro;
 }
 
 
@@ -0,0 +1,404 @@
+#include <stdlib.h>
+#include <string.h>
+#include "csr.h"
+#include "create.h"
+#include "pool.h"
+#include "binary.h"
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Inicializa uma matriz CSR vazia com capacidade para `nnz` elementos.
+ *
+ * Aloca `row_ptr` (linhas + 1 posições, zeradas) e os vetores `col_idx` e
+ * `values` com `nnz` posições. Cabe ao chamador preencher os vetores.
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ * @param nnz Número de elementos não nulos (>= 0).
+ *
+ * @return Ponteiro para a matriz alocada em caso de sucesso.
+ * @return NULL se os parâmetros forem inválidos ou se falhar alguma alocação.
+ *
+ * @post c->row_ptr[i] == 0 para todo i; c->nnz == nnz.
+ */
+MatrixCSR* csr_init(int linhas, int colunas, int nnz) {
+    if (linhas <= 0 || colunas <= 0 || nnz < 0) return NULL;
+
+    MatrixCSR *c = (MatrixCSR*)malloc(sizeof(MatrixCSR));
+    if (!c) return NULL;
+
+    c->linhas = linhas;
+    c->colunas = colunas;
+    c->nnz = nnz;
+    c->mapa = NULL;
+    c->mapa_tam = 0;
+    c->row_ptr = (int*)calloc((size_t)linhas + 1, sizeof(int));
+    c->col_idx = (int*)malloc((nnz ? (size_t)nnz : 1) * sizeof(int));
+    c->values = (float*)malloc((nnz ? (size_t)nnz : 1) * sizeof(float));
+
+    if (!c->row_ptr || !c->col_idx || !c->values) {
+        csr_destroy(c);
+        return NULL;
+    }
+    return c;
+}
+
+/**
+ * @brief Libera toda a memória associada a uma matriz CSR.
+ *
+ * Se a matriz foi obtida por `csr_map_binary`, desfaz o mapeamento do arquivo.
+ *
+ * @param c Ponteiro para a matriz a ser destruída.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c` for NULL.
+ */
+int csr_destroy(MatrixCSR *c) {
+    if (!c) return 1;
+
+    if (c->mapa) return csr_unmap_binary(c);
+
+    free(c->row_ptr);
+    free(c->col_idx);
+    free(c->values);
+    free(c);
+    return 0;
+}
+
+/**
+ * @brief Converte uma matriz em listas encadeadas para o formato CSR.
+ *
+ * Faz uma passada para contar os elementos de cada linha e outra para copiar
+ * colunas e valores para os vetores contíguos. Como as listas já estão
+ * ordenadas por coluna, as linhas do CSR também ficam ordenadas.
+ *
+ * @param m Ponteiro constante para a matriz de origem.
+ * @param r Endereço de ponteiro que receberá a matriz CSR.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int csr_from_matrix(const Matrix *m, MatrixCSR **r) {
+    if (!m || !m->mat || !r) return 1;
+    *r = NULL;
+
+    int nnz = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) nnz++;
+    }
+
+    MatrixCSR *c = csr_init(m->linhas, m->colunas, nnz);
+    if (!c) return 1;
+
+    int k = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        c->row_ptr[i] = k;
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            c->col_idx[k] = p->coluna - 1;
+            c->values[k] = p->valor;
+            k++;
+        }
+    }
+    c->row_ptr[m->linhas] = k;
+
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Converte uma matriz CSR para a representação em listas encadeadas.
+ *
+ * Todos os nós são reservados de uma vez no alocador da matriz e cada linha é
+ * montada em ordem, anexando os nós ao final da lista, sem percorrer a lista a
+ * partir da cabeça a cada inserção.
+ *
+ * @param c Ponteiro constante para a matriz CSR de origem.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int csr_to_matrix(const MatrixCSR *c, Matrix **r) {
+    if (!c || !r) return 1;
+    *r = NULL;
+
+    Matrix *res = init_matrix(c->linhas, c->colunas);
+    if (!res) return 1;
+    if (pool_reserve(&res->pool, c->nnz)) {
+        matrix_destroy(res);
+        return 1;
+    }
+
+    for (int i = 0; i < c->linhas; i++) {
+        POINT *cauda = &res->mat[i];
+        for (int k = c->row_ptr[i]; k < c->row_ptr[i + 1]; k++) {
+            if (c->values[k] == 0.0f) continue;
+
+            No *novo = pool_alloc(&res->pool);
+            if (!novo) {
+                matrix_destroy(res);
+                return 1;
+            }
+            novo->coluna = c->col_idx[k] + 1;
+            novo->valor = c->values[k];
+            novo->prox = NULL;
+
+            *cauda = novo;
+            cauda = &novo->prox;
+        }
+    }
+
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Obtém o valor de um elemento da matriz CSR.
+ *
+ * Faz busca binária nas colunas da linha x, que estão ordenadas.
+ * As posições x e y seguem indexação iniciando em 1, como em `matrix_getelem`.
+ *
+ * @param c Ponteiro constante para a matriz CSR.
+ * @param x Índice da linha (1 ≤ x ≤ c->linhas).
+ * @param y Índice da coluna (1 ≤ y ≤ c->colunas).
+ * @param elem Ponteiro para armazenar o valor do elemento encontrado.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c`/`elem` forem NULL ou se os índices estiverem fora dos limites.
+ *
+ * @post `*elem` contém o valor do elemento (x, y) ou 0.0 se ele não estiver armazenado.
+ */
+int csr_getelem(const MatrixCSR *c, int x, int y, float *elem) {
+    if (!c || !elem) return 1;
+    if (x < 1 || x > c->linhas) return 1;
+    if (y < 1 || y > c->colunas) return 1;
+
+    int ini = c->row_ptr[x - 1];
+    int fim = c->row_ptr[x];
+    int alvo = y - 1;
+
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (c->col_idx[meio] < alvo) ini = meio + 1;
+        else fim = meio;
+    }
+
+    if (ini < c->row_ptr[x] && c->col_idx[ini] == alvo) *elem = c->values[ini];
+    else *elem = 0.0f;
+
+    return 0;
+}
+
+/**
+ * @brief Calcula a soma de duas matrizes CSR de mesmas dimensões.
+ *
+ * Intercala as linhas de `a` e `b` (ordenadas por coluna) em uma única
+ * passada. Elementos cujo resultado seja 0.0 não são armazenados.
+ *
+ * @param a Ponteiro constante para a primeira matriz.
+ * @param b Ponteiro constante para a segunda matriz.
+ * @param r Endereço de ponteiro que receberá a matriz resultante.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int csr_add(const MatrixCSR *a, const MatrixCSR *b, MatrixCSR **r) {
+    if (!a || !b || !r) return 1;
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 1;
+    *r = NULL;
+
+    MatrixCSR *c = csr_init(a->linhas, a->colunas, a->nnz + b->nnz);
+    if (!c) return 1;
+
+    int k = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int pa = a->row_ptr[i], fa = a->row_ptr[i + 1];
+        int pb = b->row_ptr[i], fb = b->row_ptr[i + 1];
+
+        c->row_ptr[i] = k;
+        while (pa < fa || pb < fb) {
+            int col;
+            float val;
+
+            if (pb >= fb || (pa < fa && a->col_idx[pa] < b->col_idx[pb])) {
+                col = a->col_idx[pa];
+                val = a->values[pa++];
+            } else if (pa >= fa || b->col_idx[pb] < a->col_idx[pa]) {
+                col = b->col_idx[pb];
+                val = b->values[pb++];
+            } else {
+                col = a->col_idx[pa];
+                val = a->values[pa++] + b->values[pb++];
+            }
+
+            if (val != 0.0f) {
+                c->col_idx[k] = col;
+                c->values[k] = val;
+                k++;
+            }
+        }
+    }
+    c->row_ptr[a->linhas] = k;
+    c->nnz = k;
+
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Calcula a transposta de uma matriz CSR.
+ *
+ * Conta os elementos de cada coluna, acumula as contagens (soma de prefixos)
+ * para obter o início de cada linha da transposta e espalha os elementos.
+ * Como as linhas de `a` são visitadas em ordem, as linhas da transposta já
+ * saem ordenadas. Custo O(nnz + linhas + colunas).
+ *
+ * @param a Ponteiro constante para a matriz de entrada.
+ * @param r Endereço de ponteiro que receberá a transposta.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `a`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para a transposta de `a`; em erro, `*r` permanece NULL.
+ */
+int csr_transpose(const MatrixCSR *a, MatrixCSR **r) {
+    if (!a || !r) return 1;
+    *r = NULL;
+
+    MatrixCSR *t = csr_init(a->colunas, a->linhas, a->nnz);
+    if (!t) return 1;
+
+    for (int k = 0; k < a->nnz; k++) t->row_ptr[a->col_idx[k] + 1]++;
+    for (int j = 0; j < a->colunas; j++) t->row_ptr[j + 1] += t->row_ptr[j];
+
+    int *pos = (int*)malloc((size_t)a->colunas * sizeof(int));
+    if (!pos) {
+        csr_destroy(t);
+        return 1;
+    }
+    memcpy(pos, t->row_ptr, (size_t)a->colunas * sizeof(int));
+
+    for (int i = 0; i < a->linhas; i++) {
+        for (int k = a->row_ptr[i]; k < a->row_ptr[i + 1]; k++) {
+            int destino = pos[a->col_idx[k]]++;
+            t->col_idx[destino] = i;
+            t->values[destino] = a->values[k];
+        }
+    }
+
+    free(pos);
+    *r = t;
+    return 0;
+}
+
+/**
+ * @brief Calcula o produto de duas matrizes CSR (algoritmo de Gustavson).
+ *
+ * Em uma passada simbólica conta, com um vetor de marcação, quantas colunas
+ * distintas cada linha do produto pode ter, e aloca o resultado de uma vez.
+ * Na passada numérica, acumula as contribuições de cada linha em um vetor
+ * denso, ordena as colunas tocadas e grava a linha já ordenada, descartando
+ * os valores que resultarem em 0.0.
+ *
+ * @param a Ponteiro constante para a matriz à esquerda (m x p).
+ * @param b Ponteiro constante para a matriz à direita (p x q).
+ * @param r Endereço de ponteiro que receberá o produto (m x q).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a->colunas != b->linhas
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int csr_multiply(const MatrixCSR *a, const MatrixCSR *b, MatrixCSR **r) {
+    if (!a || !b || !r) return 1;
+    if (a->colunas != b->linhas) return 1;
+    *r = NULL;
+
+    int q = b->colunas;
+    int *marca = (int*)malloc((size_t)q * sizeof(int));
+    double *acc = (double*)calloc((size_t)q, sizeof(double));
+    if (!marca || !acc) {
+        free(marca);
+        free(acc);
+        return 1;
+    }
+    for (int j = 0; j < q; j++) marca[j] = -1;
+
+    /* passada simbólica: limite superior de nnz por linha */
+    long long total = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        for (int ka = a->row_ptr[i]; ka < a->row_ptr[i + 1]; ka++) {
+            int k = a->col_idx[ka];
+            for (int kb = b->row_ptr[k]; kb < b->row_ptr[k + 1]; kb++) {
+                int j = b->col_idx[kb];
+                if (marca[j] != i) {
+                    marca[j] = i;
+                    total++;
+                }
+            }
+        }
+    }
+
+    MatrixCSR *c = (total > 0x7fffffff) ? NULL : csr_init(a->linhas, q, (int)total);
+    if (!c) {
+        free(marca);
+        free(acc);
+        return 1;
+    }
+    for (int j = 0; j < q; j++) marca[j] = -1;
+
+    /* passada numérica */
+    int k_out = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int ini = k_out;
+        c->row_ptr[i] = ini;
+
+        for (int ka = a->row_ptr[i]; ka < a->row_ptr[i + 1]; ka++) {
+            int k = a->col_idx[ka];
+            double va = a->values[ka];
+            for (int kb = b->row_ptr[k]; kb < b->row_ptr[k + 1]; kb++) {
+                int j = b->col_idx[kb];
+                if (marca[j] != i) {
+                    marca[j] = i;
+                    c->col_idx[k_out++] = j;
+                }
+                acc[j] += va * b->values[kb];
+            }
+        }
+
+        qsort(c->col_idx + ini, (size_t)(k_out - ini), sizeof(int), cmp_int);
+
+        int w = ini;
+        for (int t = ini; t < k_out; t++) {
+            int j = c->col_idx[t];
+            float v = (float)acc[j];
+            acc[j] = 0.0;
+            if (v != 0.0f) {
+                c->col_idx[w] = j;
+                c->values[w] = v;
+                w++;
+            }
+        }
+        k_out = w;
+    }
+    c->row_ptr[a->linhas] = k_out;
+    c->nnz = k_out;
+
+    free(marca);
+    free(acc);
+    *r = c;
+    return 0;
+}
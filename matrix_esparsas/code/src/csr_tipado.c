@@ -0,0 +1,40 @@
+#include <stdlib.h>
+#include <string.h>
+#include "csr_tipado.h"
+#include "coo.h"
+
+/*
+ * Instancia as operações de csr_tipado_modelo.h para cada tipo de valor.
+ * Cada variante tem seus próprios kernels, sem ponteiros de função nem
+ * despacho em tempo de execução.
+ */
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+#define CSR_SUF d
+#define CSR_VALOR double
+#define CSR_ACUM double
+#include "csr_tipado_modelo.h"
+#undef CSR_SUF
+#undef CSR_VALOR
+#undef CSR_ACUM
+
+#define CSR_SUF i
+#define CSR_VALOR int32_t
+#define CSR_ACUM long long
+#include "csr_tipado_modelo.h"
+#undef CSR_SUF
+#undef CSR_VALOR
+#undef CSR_ACUM
+
+#define CSR_SUF p
+#define CSR_ACUM double
+#define CSR_PADRAO
+#include "csr_tipado_modelo.h"
+#undef CSR_SUF
+#undef CSR_ACUM
+#undef CSR_PADRAO
@@ -0,0 +1,510 @@
+/*
+ * Modelo das operações CSR tipadas, incluído por csr_tipado.c uma vez por tipo.
+ * Não tem include guard de propósito.
+ *
+ * Parâmetros, definidos antes da inclusão e desfeitos ao final:
+ *   CSR_SUF     sufixo do tipo (d, i, p);
+ *   CSR_VALOR   tipo dos valores armazenados (ausente na variante de padrão);
+ *   CSR_ACUM    tipo usado para acumular somas e produtos;
+ *   CSR_PADRAO  definido na variante de padrão, que não tem vetor de valores.
+ */
+
+#define CSR_JUNTA_(a, b) a##_##b
+#define CSR_JUNTA(a, b) CSR_JUNTA_(a, b)
+#define CSR_T CSR_JUNTA(MatrixCSR, CSR_SUF)
+#define CSR_F(nome) CSR_JUNTA(nome, CSR_SUF)
+
+#ifdef CSR_PADRAO
+#define CSR_ELEM int
+#define CSR_VETOR float
+#else
+#define CSR_ELEM CSR_VALOR
+#define CSR_VETOR CSR_VALOR
+#endif
+
+/**
+ * @brief Inicializa uma matriz CSR tipada vazia com capacidade para `nnz` elementos.
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ * @param nnz Número de elementos não nulos (>= 0).
+ *
+ * @return Ponteiro para a matriz alocada em caso de sucesso.
+ * @return NULL se os parâmetros forem inválidos ou se falhar alguma alocação.
+ *
+ * @post c->row_ptr[i] == 0 para todo i; c->nnz == nnz.
+ */
+CSR_T* CSR_F(csr_init)(int linhas, int colunas, int nnz) {
+    if (linhas <= 0 || colunas <= 0 || nnz < 0) return NULL;
+
+    CSR_T *c = (CSR_T*)malloc(sizeof(CSR_T));
+    if (!c) return NULL;
+
+    c->linhas = linhas;
+    c->colunas = colunas;
+    c->nnz = nnz;
+    c->row_ptr = (int*)calloc((size_t)linhas + 1, sizeof(int));
+    c->col_idx = (int*)malloc((nnz ? (size_t)nnz : 1) * sizeof(int));
+#ifdef CSR_PADRAO
+    if (!c->row_ptr || !c->col_idx) {
+#else
+    c->values = (CSR_VALOR*)malloc((nnz ? (size_t)nnz : 1) * sizeof(CSR_VALOR));
+    if (!c->row_ptr || !c->col_idx || !c->values) {
+#endif
+        CSR_F(csr_destroy)(c);
+        return NULL;
+    }
+    return c;
+}
+
+/**
+ * @brief Libera toda a memória associada a uma matriz CSR tipada.
+ *
+ * @param c Ponteiro para a matriz a ser destruída.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c` for NULL.
+ */
+int CSR_F(csr_destroy)(CSR_T *c) {
+    if (!c) return 1;
+
+    free(c->row_ptr);
+    free(c->col_idx);
+#ifndef CSR_PADRAO
+    free(c->values);
+#endif
+    free(c);
+    return 0;
+}
+
+/**
+ * @brief Converte uma matriz em listas encadeadas (float) para o tipo desta variante.
+ *
+ * Os valores são convertidos com cast de C (truncamento, no caso de int32);
+ * os que viram 0 na conversão são descartados. A variante de padrão guarda
+ * apenas a estrutura.
+ *
+ * @param m Ponteiro constante para a matriz de origem.
+ * @param r Endereço de ponteiro que receberá a matriz CSR.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int CSR_F(csr_from_matrix)(const Matrix *m, CSR_T **r) {
+    if (!m || !m->mat || !r) return 1;
+    *r = NULL;
+
+    int nnz = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+#ifdef CSR_PADRAO
+            nnz++;
+#else
+            if ((CSR_VALOR)p->valor != 0) nnz++;
+#endif
+        }
+    }
+
+    CSR_T *c = CSR_F(csr_init)(m->linhas, m->colunas, nnz);
+    if (!c) return 1;
+
+    int k = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        c->row_ptr[i] = k;
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+#ifndef CSR_PADRAO
+            CSR_VALOR v = (CSR_VALOR)p->valor;
+            if (v == 0) continue;
+            c->values[k] = v;
+#endif
+            c->col_idx[k++] = p->coluna - 1;
+        }
+    }
+    c->row_ptr[m->linhas] = k;
+
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Monta uma matriz CSR tipada a partir de triplas (i, j[, valor]).
+ *
+ * Mesmo comportamento de `csr_from_coo`: as triplas são ordenadas por
+ * `coo_sort_perm`, repetições são somadas (em CSR_ACUM) e somas nulas são
+ * descartadas. Na variante de padrão as repetições são apenas unificadas.
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ * @param is Índices de linha (base 1).
+ * @param js Índices de coluna (base 1).
+ * @param vals Valores (ausente na variante de padrão).
+ * @param nnz Número de triplas.
+ * @param r Endereço de ponteiro que receberá a matriz CSR.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem inválidas ou se falhar alguma alocação.
+ * @return 2 se algum índice estiver fora dos limites.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+#ifdef CSR_PADRAO
+int CSR_F(csr_from_coo)(int linhas, int colunas, const int *is, const int *js, int nnz, CSR_T **r) {
+    if (!r) return 1;
+    *r = NULL;
+#else
+int CSR_F(csr_from_coo)(int linhas, int colunas, const int *is, const int *js,
+                        const CSR_VALOR *vals, int nnz, CSR_T **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (nnz > 0 && !vals) return 1;
+#endif
+
+    CSR_T *c = CSR_F(csr_init)(linhas, colunas, nnz);
+    if (!c) return 1;
+
+    int *perm = (int*)malloc((nnz ? (size_t)nnz : 1) * sizeof(int));
+    if (!perm) {
+        CSR_F(csr_destroy)(c);
+        return 1;
+    }
+
+    int erro = coo_sort_perm(linhas, colunas, is, js, nnz, perm);
+    if (erro) {
+        free(perm);
+        CSR_F(csr_destroy)(c);
+        return erro;
+    }
+
+    int w = 0;
+    int t = 0;
+    for (int i = 1; i <= linhas; i++) {
+        c->row_ptr[i - 1] = w;
+
+        while (t < nnz && is[perm[t]] == i) {
+            int j = js[perm[t]];
+#ifdef CSR_PADRAO
+            while (t < nnz && is[perm[t]] == i && js[perm[t]] == j) t++;
+            c->col_idx[w++] = j - 1;
+#else
+            CSR_ACUM soma = 0;
+            while (t < nnz && is[perm[t]] == i && js[perm[t]] == j) {
+                soma += vals[perm[t]];
+                t++;
+            }
+            if ((CSR_VALOR)soma != 0) {
+                c->col_idx[w] = j - 1;
+                c->values[w] = (CSR_VALOR)soma;
+                w++;
+            }
+#endif
+        }
+    }
+    c->row_ptr[linhas] = w;
+    c->nnz = w;
+
+    free(perm);
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Obtém o valor de um elemento (busca binária na linha).
+ *
+ * Na variante de padrão, `*elem` recebe 1 se o elemento estiver armazenado e 0 caso contrário.
+ *
+ * @param c Ponteiro constante para a matriz.
+ * @param x Índice da linha (1 ≤ x ≤ c->linhas).
+ * @param y Índice da coluna (1 ≤ y ≤ c->colunas).
+ * @param elem Ponteiro para armazenar o valor do elemento.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c`/`elem` forem NULL ou se os índices estiverem fora dos limites.
+ */
+int CSR_F(csr_getelem)(const CSR_T *c, int x, int y, CSR_ELEM *elem) {
+    if (!c || !elem) return 1;
+    if (x < 1 || x > c->linhas) return 1;
+    if (y < 1 || y > c->colunas) return 1;
+
+    int ini = c->row_ptr[x - 1];
+    int fim = c->row_ptr[x];
+    int alvo = y - 1;
+
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (c->col_idx[meio] < alvo) ini = meio + 1;
+        else fim = meio;
+    }
+
+    int achou = ini < c->row_ptr[x] && c->col_idx[ini] == alvo;
+#ifdef CSR_PADRAO
+    *elem = achou;
+#else
+    *elem = achou ? c->values[ini] : 0;
+#endif
+    return 0;
+}
+
+/**
+ * @brief Soma duas matrizes CSR tipadas de mesmas dimensões.
+ *
+ * Intercala as linhas em uma única passada; somas nulas são descartadas.
+ * Na variante de padrão o resultado é a união das estruturas.
+ *
+ * @param a Ponteiro constante para a primeira matriz.
+ * @param b Ponteiro constante para a segunda matriz.
+ * @param r Endereço de ponteiro que receberá a matriz resultante.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int CSR_F(csr_add)(const CSR_T *a, const CSR_T *b, CSR_T **r) {
+    if (!a || !b || !r) return 1;
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 1;
+    *r = NULL;
+
+    CSR_T *c = CSR_F(csr_init)(a->linhas, a->colunas, a->nnz + b->nnz);
+    if (!c) return 1;
+
+    int k = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int pa = a->row_ptr[i], fa = a->row_ptr[i + 1];
+        int pb = b->row_ptr[i], fb = b->row_ptr[i + 1];
+
+        c->row_ptr[i] = k;
+        while (pa < fa || pb < fb) {
+            int col;
+#ifdef CSR_PADRAO
+            if (pb >= fb || (pa < fa && a->col_idx[pa] < b->col_idx[pb])) {
+                col = a->col_idx[pa++];
+            } else if (pa >= fa || b->col_idx[pb] < a->col_idx[pa]) {
+                col = b->col_idx[pb++];
+            } else {
+                col = a->col_idx[pa++];
+                pb++;
+            }
+            c->col_idx[k++] = col;
+#else
+            CSR_VALOR val;
+            if (pb >= fb || (pa < fa && a->col_idx[pa] < b->col_idx[pb])) {
+                col = a->col_idx[pa];
+                val = a->values[pa++];
+            } else if (pa >= fa || b->col_idx[pb] < a->col_idx[pa]) {
+                col = b->col_idx[pb];
+                val = b->values[pb++];
+            } else {
+                col = a->col_idx[pa];
+                val = (CSR_VALOR)((CSR_ACUM)a->values[pa++] + b->values[pb++]);
+            }
+
+            if (val != 0) {
+                c->col_idx[k] = col;
+                c->values[k] = val;
+                k++;
+            }
+#endif
+        }
+    }
+    c->row_ptr[a->linhas] = k;
+    c->nnz = k;
+
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Calcula a transposta de uma matriz CSR tipada (contagem + soma de prefixos).
+ *
+ * @param a Ponteiro constante para a matriz de entrada.
+ * @param r Endereço de ponteiro que receberá a transposta.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `a`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para a transposta de `a`; em erro, `*r` permanece NULL.
+ */
+int CSR_F(csr_transpose)(const CSR_T *a, CSR_T **r) {
+    if (!a || !r) return 1;
+    *r = NULL;
+
+    CSR_T *t = CSR_F(csr_init)(a->colunas, a->linhas, a->nnz);
+    if (!t) return 1;
+
+    for (int k = 0; k < a->nnz; k++) t->row_ptr[a->col_idx[k] + 1]++;
+    for (int j = 0; j < a->colunas; j++) t->row_ptr[j + 1] += t->row_ptr[j];
+
+    int *pos = (int*)malloc((size_t)a->colunas * sizeof(int));
+    if (!pos) {
+        CSR_F(csr_destroy)(t);
+        return 1;
+    }
+    memcpy(pos, t->row_ptr, (size_t)a->colunas * sizeof(int));
+
+    for (int i = 0; i < a->linhas; i++) {
+        for (int k = a->row_ptr[i]; k < a->row_ptr[i + 1]; k++) {
+            int destino = pos[a->col_idx[k]]++;
+            t->col_idx[destino] = i;
+#ifndef CSR_PADRAO
+            t->values[destino] = a->values[k];
+#endif
+        }
+    }
+
+    free(pos);
+    *r = t;
+    return 0;
+}
+
+/**
+ * @brief Calcula o produto de duas matrizes CSR tipadas (algoritmo de Gustavson).
+ *
+ * Passada simbólica para dimensionar o resultado e passada numérica com
+ * acumulador denso do tipo CSR_ACUM (double para _d, int64 para _i; o valor
+ * final de _i é truncado para int32). Na variante de padrão o produto é
+ * booleano: só a passada de marcação é feita, sem acumulador.
+ *
+ * @param a Ponteiro constante para a matriz à esquerda (m x p).
+ * @param b Ponteiro constante para a matriz à direita (p x q).
+ * @param r Endereço de ponteiro que receberá o produto (m x q).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a->colunas != b->linhas
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int CSR_F(csr_multiply)(const CSR_T *a, const CSR_T *b, CSR_T **r) {
+    if (!a || !b || !r) return 1;
+    if (a->colunas != b->linhas) return 1;
+    *r = NULL;
+
+    int q = b->colunas;
+    int *marca = (int*)malloc((size_t)q * sizeof(int));
+#ifdef CSR_PADRAO
+    if (!marca) return 1;
+#else
+    CSR_ACUM *acc = (CSR_ACUM*)calloc((size_t)q, sizeof(CSR_ACUM));
+    if (!marca || !acc) {
+        free(marca);
+        free(acc);
+        return 1;
+    }
+#endif
+    for (int j = 0; j < q; j++) marca[j] = -1;
+
+    /* passada simbólica: limite superior de nnz por linha */
+    long long total = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        for (int ka = a->row_ptr[i]; ka < a->row_ptr[i + 1]; ka++) {
+            int k = a->col_idx[ka];
+            for (int kb = b->row_ptr[k]; kb < b->row_ptr[k + 1]; kb++) {
+                int j = b->col_idx[kb];
+                if (marca[j] != i) {
+                    marca[j] = i;
+                    total++;
+                }
+            }
+        }
+    }
+
+    CSR_T *c = (total > 0x7fffffff) ? NULL : CSR_F(csr_init)(a->linhas, q, (int)total);
+    if (!c) {
+        free(marca);
+#ifndef CSR_PADRAO
+        free(acc);
+#endif
+        return 1;
+    }
+    for (int j = 0; j < q; j++) marca[j] = -1;
+
+    /* passada numérica */
+    int k_out = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int ini = k_out;
+        c->row_ptr[i] = ini;
+
+        for (int ka = a->row_ptr[i]; ka < a->row_ptr[i + 1]; ka++) {
+            int k = a->col_idx[ka];
+#ifndef CSR_PADRAO
+            CSR_ACUM va = a->values[ka];
+#endif
+            for (int kb = b->row_ptr[k]; kb < b->row_ptr[k + 1]; kb++) {
+                int j = b->col_idx[kb];
+                if (marca[j] != i) {
+                    marca[j] = i;
+                    c->col_idx[k_out++] = j;
+                }
+#ifndef CSR_PADRAO
+                acc[j] += va * b->values[kb];
+#endif
+            }
+        }
+
+        qsort(c->col_idx + ini, (size_t)(k_out - ini), sizeof(int), cmp_int);
+
+#ifndef CSR_PADRAO
+        int w = ini;
+        for (int t = ini; t < k_out; t++) {
+            int j = c->col_idx[t];
+            CSR_VALOR v = (CSR_VALOR)acc[j];
+            acc[j] = 0;
+            if (v != 0) {
+                c->col_idx[w] = j;
+                c->values[w] = v;
+                w++;
+            }
+        }
+        k_out = w;
+#endif
+    }
+    c->row_ptr[a->linhas] = k_out;
+    c->nnz = k_out;
+
+    free(marca);
+#ifndef CSR_PADRAO
+    free(acc);
+#endif
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Produto matriz-vetor y = A * x, acumulando cada linha em CSR_ACUM.
+ *
+ * Na variante de padrão os vetores são float e y[i] é a soma de x nas colunas
+ * armazenadas da linha i.
+ *
+ * @param a Ponteiro constante para a matriz (linhas x colunas).
+ * @param x Vetor denso com a->colunas posições.
+ * @param y Vetor denso com a->linhas posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int CSR_F(csr_spmv)(const CSR_T *a, const CSR_VETOR *x, CSR_VETOR *y) {
+    if (!a || !x || !y) return 1;
+
+    for (int i = 0; i < a->linhas; i++) {
+        CSR_ACUM soma = 0;
+        for (int k = a->row_ptr[i]; k < a->row_ptr[i + 1]; k++) {
+#ifdef CSR_PADRAO
+            soma += x[a->col_idx[k]];
+#else
+            soma += (CSR_ACUM)a->values[k] * x[a->col_idx[k]];
+#endif
+        }
+        y[i] = (CSR_VETOR)soma;
+    }
+    return 0;
+}
+
+#undef CSR_JUNTA_
+#undef CSR_JUNTA
+#undef CSR_T
+#undef CSR_F
+#undef CSR_ELEM
+#undef CSR_VETOR
@@ -0,0 +1,422 @@
+#include <stdlib.h>
+#include "elementwise.h"
+#include "create.h"
+#include "csr.h"
+#include "pool.h"
+#include "indice.h"
+
+typedef enum OpElemento {
+    OP_PRODUTO,
+    OP_MASCARA,
+    OP_COMPLEMENTO
+} OpElemento;
+
+/*
+ * Primeira posição p em [ini, fim) com col[p] >= alvo. Avança a partir de
+ * `ini` com passos 1, 2, 4, ... e termina com busca binária no último
+ * intervalo: O(log d), onde d é a distância percorrida.
+ */
+static int galopa(const int *col, int ini, int fim, int alvo) {
+    if (ini >= fim || col[ini] >= alvo) return ini;
+
+    int lo = ini, passo = 1;
+    while (lo + passo < fim && col[lo + passo] < alvo) {
+        lo += passo;
+        passo *= 2;
+    }
+
+    int hi = lo + passo < fim ? lo + passo : fim;
+    lo++;
+    while (lo < hi) {
+        int meio = lo + (hi - lo) / 2;
+        if (col[meio] < alvo) lo = meio + 1;
+        else hi = meio;
+    }
+    return lo;
+}
+
+/* 1 se a lista `p` tiver no máximo n_longa / HADAMARD_GALOPE nós (conta só até esse limite). */
+static int curta(POINT p, int n_longa) {
+    int limite = n_longa / HADAMARD_GALOPE;
+    int n = 0;
+    for (; p && n <= limite; p = p->prox) n++;
+    return n <= limite && n_longa > 0;
+}
+
+/*
+ * Busca, em colunas crescentes, nos nós de uma linha: pelo índice com busca
+ * galopante ou, sem ele, avançando pela lista.
+ */
+typedef struct Cursor {
+    POINT p;
+    const IndiceLinha *ix;
+    int pos;
+} Cursor;
+
+static void cursor_init(Cursor *c, const Matrix *s, int i, POINT percorrida) {
+    c->p = s->mat[i];
+    c->pos = 0;
+    c->ix = (s->indice && curta(percorrida, s->indice[i].n)) ? &s->indice[i] : NULL;
+}
+
+static POINT cursor_busca(Cursor *c, int coluna) {
+    if (c->ix) {
+        c->pos = galopa(c->ix->colunas, c->pos, c->ix->n, coluna);
+        return (c->pos < c->ix->n && c->ix->colunas[c->pos] == coluna) ? c->ix->nos[c->pos] : NULL;
+    }
+
+    while (c->p && c->p->coluna < coluna) c->p = c->p->prox;
+    return (c->p && c->p->coluna == coluna) ? c->p : NULL;
+}
+
+/* Valor de r(i, j) a partir de m(i, j) e do nó de n na mesma posição (NULL se ausente); 0.0 descarta. */
+static float combina(OpElemento op, float vm, POINT pn) {
+    switch (op) {
+        case OP_PRODUTO: return pn ? vm * pn->valor : 0.0f;
+        case OP_MASCARA: return pn ? vm : 0.0f;
+        default: return pn ? 0.0f : vm;
+    }
+}
+
+/*
+ * Linha i de `op(m, n)`, anexada a `saida`. Percorre a linha de m e busca em
+ * n; se n for a linha curta e m tiver índice, percorre n e busca em m (o
+ * complemento precisa de todos os elementos de m, então não troca).
+ */
+static int elemento_linha(const Matrix *m, const Matrix *n, int i, OpElemento op, NoPool *pool, POINT *saida) {
+    int troca = op != OP_COMPLEMENTO && m->indice && curta(n->mat[i], m->indice[i].n);
+    const Matrix *w = troca ? n : m;
+    const Matrix *s = troca ? m : n;
+    POINT *cauda = saida;
+
+    Cursor c;
+    cursor_init(&c, s, i, w->mat[i]);
+
+    for (POINT p = w->mat[i]; p; p = p->prox) {
+        POINT q = cursor_busca(&c, p->coluna);
+        POINT pm = troca ? q : p;
+        POINT pn = troca ? p : q;
+        if (!pm) continue;
+
+        float v = combina(op, pm->valor, pn);
+        if (v == 0.0f) continue;
+
+        No *novo = pool_alloc(pool);
+        if (!novo) return 1;
+        novo->coluna = p->coluna;
+        novo->valor = v;
+        novo->prox = NULL;
+        *cauda = novo;
+        cauda = &novo->prox;
+    }
+    return 0;
+}
+
+static int elemento_novo(const Matrix *m, const Matrix *n, OpElemento op, Matrix **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (!m || !n || !m->mat || !n->mat) return 1;
+    if (m->linhas != n->linhas || m->colunas != n->colunas) return 1;
+
+    Matrix *res = init_matrix(m->linhas, m->colunas);
+    if (!res) return 1;
+
+    for (int i = 0; i < m->linhas; i++) {
+        if (elemento_linha(m, n, i, op, &res->pool, &res->mat[i])) {
+            matrix_destroy(res);
+            return 1;
+        }
+    }
+
+    *r = res;
+    return 0;
+}
+
+/*
+ * Aplica `op` no lugar: percorre a linha de m, regrava os valores e devolve
+ * ao alocador os nós que resultam em 0.0. Refaz o índice das linhas que
+ * perderam nós; se isso falhar, o índice é desligado.
+ */
+static int elemento_inplace(Matrix *m, const Matrix *n, OpElemento op) {
+    if (!m || !n || !m->mat || !n->mat) return 1;
+    if (m->linhas != n->linhas || m->colunas != n->colunas) return 1;
+    if (m == n) return 1;
+
+    int erro = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        Cursor c;
+        cursor_init(&c, n, i, m->mat[i]);
+
+        int removidos = 0;
+        POINT *ant = &m->mat[i];
+        while (*ant) {
+            POINT p = *ant;
+            float v = combina(op, p->valor, cursor_busca(&c, p->coluna));
+
+            if (v == 0.0f) {
+                *ant = p->prox;
+                pool_free(&m->pool, p);
+                removidos++;
+            } else {
+                p->valor = v;
+                ant = &p->prox;
+            }
+        }
+
+        if (removidos && m->indice && !erro && indice_reconstroi_linha(m, i)) erro = 1;
+    }
+
+    if (erro) matrix_index_disable(m);
+    return erro;
+}
+
+/**
+ * @brief Calcula o produto elemento a elemento (Hadamard) r = m ∘ n.
+ *
+ * Cada linha do resultado é a interseção das linhas de m e n, em tempo linear
+ * (intercalação das listas). Se uma das linhas for HADAMARD_GALOPE vezes mais
+ * curta que a outra e a longa tiver o índice por linha ligado
+ * (`matrix_index_enable`), a curta é percorrida e a longa é buscada por busca
+ * galopante, em O(curta * log(longa / curta)).
+ * Produtos que resultem em 0.0 não são armazenados.
+ *
+ * @param m Ponteiro constante para a primeira matriz.
+ * @param n Ponteiro constante para a segunda matriz.
+ * @param r Endereço de ponteiro que receberá a matriz resultante.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_hadamard(const Matrix *m, const Matrix *n, Matrix **r) {
+    return elemento_novo(m, n, OP_PRODUTO, r);
+}
+
+/**
+ * @brief Calcula m = m ∘ n no lugar.
+ *
+ * Os elementos de m sem correspondente em n (ou cujo produto resulte em 0.0)
+ * são removidos e voltam ao alocador de m. A linha de m é sempre percorrida
+ * inteira; a de n é buscada por busca galopante se tiver o índice ligado e
+ * for HADAMARD_GALOPE vezes mais longa. O índice por linha de m, se ligado, é
+ * mantido.
+ *
+ * @param m Ponteiro para a matriz alterada.
+ * @param n Ponteiro constante para a segunda matriz (diferente de m).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis,
+ *         se n for a mesma matriz que m, ou se falhar a reconstrução do índice
+ *         (o índice de m é desligado; os valores ficam corretos).
+ */
+int matrix_hadamard_inplace(Matrix *m, const Matrix *n) {
+    return elemento_inplace(m, n, OP_PRODUTO);
+}
+
+/**
+ * @brief Produto elemento a elemento (Hadamard) no formato CSR.
+ *
+ * Por linha, intercala os vetores de colunas ou, se uma linha for
+ * HADAMARD_GALOPE vezes mais curta que a outra, percorre a curta e busca na
+ * longa por busca galopante.
+ *
+ * @param a Ponteiro constante para a primeira matriz CSR.
+ * @param b Ponteiro constante para a segunda matriz CSR.
+ * @param r Endereço de ponteiro que receberá o resultado.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int csr_hadamard(const MatrixCSR *a, const MatrixCSR *b, MatrixCSR **r) {
+    if (!a || !b || !r) return 1;
+    *r = NULL;
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 1;
+
+    MatrixCSR *c = csr_init(a->linhas, a->colunas, a->nnz < b->nnz ? a->nnz : b->nnz);
+    if (!c) return 1;
+
+    int k = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int pa = a->row_ptr[i], fa = a->row_ptr[i + 1];
+        int pb = b->row_ptr[i], fb = b->row_ptr[i + 1];
+        c->row_ptr[i] = k;
+
+        if ((long long)(fa - pa) * HADAMARD_GALOPE <= fb - pb || (long long)(fb - pb) * HADAMARD_GALOPE <= fa - pa) {
+            /* percorre a curta (s) e galopa na longa (l) */
+            int a_curta = fa - pa <= fb - pb;
+            const MatrixCSR *s = a_curta ? a : b, *l = a_curta ? b : a;
+            int ps = a_curta ? pa : pb, fs = a_curta ? fa : fb;
+            int pl = a_curta ? pb : pa, fl = a_curta ? fb : fa;
+
+            for (; ps < fs && pl < fl; ps++) {
+                pl = galopa(l->col_idx, pl, fl, s->col_idx[ps]);
+                if (pl < fl && l->col_idx[pl] == s->col_idx[ps]) {
+                    float v = s->values[ps] * l->values[pl];
+                    if (v != 0.0f) {
+                        c->col_idx[k] = s->col_idx[ps];
+                        c->values[k++] = v;
+                    }
+                }
+            }
+            continue;
+        }
+
+        while (pa < fa && pb < fb) {
+            if (a->col_idx[pa] < b->col_idx[pb]) {
+                pa++;
+            } else if (b->col_idx[pb] < a->col_idx[pa]) {
+                pb++;
+            } else {
+                float v = a->values[pa] * b->values[pb];
+                if (v != 0.0f) {
+                    c->col_idx[k] = a->col_idx[pa];
+                    c->values[k++] = v;
+                }
+                pa++;
+                pb++;
+            }
+        }
+    }
+    c->row_ptr[a->linhas] = k;
+    c->nnz = k;
+
+    *r = c;
+    return 0;
+}
+
+/**
+ * @brief Seleciona os elementos de m pela estrutura de uma máscara.
+ *
+ * Com `complemento == 0`, r(i, j) = m(i, j) onde a máscara tem elemento
+ * armazenado; caso contrário, onde ela não tem. Os valores da máscara são
+ * ignorados. Tempo linear por linha, com a mesma busca galopante de
+ * `matrix_hadamard` quando possível.
+ *
+ * @param m Ponteiro constante para a matriz de origem.
+ * @param mascara Ponteiro constante para a máscara (mesmas dimensões de m).
+ * @param complemento 0 mantém as posições da máscara; != 0 as remove.
+ * @param r Endereço de ponteiro que receberá a matriz resultante.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_mask(const Matrix *m, const Matrix *mascara, int complemento, Matrix **r) {
+    return elemento_novo(m, mascara, complemento ? OP_COMPLEMENTO : OP_MASCARA, r);
+}
+
+/**
+ * @brief Versão no lugar de `matrix_mask`: remove de m os elementos rejeitados pela máscara.
+ *
+ * @param m Ponteiro para a matriz alterada (o índice por linha, se ligado, é mantido).
+ * @param mascara Ponteiro constante para a máscara (diferente de m).
+ * @param complemento 0 mantém as posições da máscara; != 0 as remove.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis,
+ *         se a máscara for a própria m, ou se falhar a reconstrução do índice
+ *         (o índice de m é desligado).
+ */
+int matrix_mask_inplace(Matrix *m, const Matrix *mascara, int complemento) {
+    return elemento_inplace(m, mascara, complemento ? OP_COMPLEMENTO : OP_MASCARA);
+}
+
+/*
+ * Regrava cada elemento armazenado de m com f; os que resultam em 0.0 saem
+ * da lista e voltam ao alocador. Mantém o índice como `elemento_inplace`.
+ */
+static int regrava(Matrix *m, FuncaoElemento f, void *dados) {
+    int erro = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        int removidos = 0;
+        POINT *ant = &m->mat[i];
+
+        while (*ant) {
+            POINT p = *ant;
+            float v = f(p->valor, i + 1, p->coluna, dados);
+
+            if (v == 0.0f) {
+                *ant = p->prox;
+                pool_free(&m->pool, p);
+                removidos++;
+            } else {
+                p->valor = v;
+                ant = &p->prox;
+            }
+        }
+
+        if (removidos && m->indice && !erro && indice_reconstroi_linha(m, i)) erro = 1;
+    }
+
+    if (erro) matrix_index_disable(m);
+    return erro;
+}
+
+static float escala(float valor, int i, int j, void *dados) {
+    (void)i;
+    (void)j;
+    return valor * *(const float*)dados;
+}
+
+static float corta(float valor, int i, int j, void *dados) {
+    (void)i;
+    (void)j;
+    float limiar = *(const float*)dados;
+    return (valor < limiar && valor > -limiar) ? 0.0f : valor;
+}
+
+/**
+ * @brief Multiplica todos os elementos de m por `alfa`, no lugar.
+ *
+ * Com alfa == 0 a matriz fica vazia; produtos que resultem em 0.0 (underflow)
+ * são removidos. O índice por linha, se ligado, é mantido.
+ *
+ * @param m Ponteiro para a matriz.
+ * @param alfa Escalar.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m` for NULL ou se falhar a reconstrução do índice (o índice é desligado).
+ */
+int matrix_scale(Matrix *m, float alfa) {
+    if (!m || !m->mat) return 1;
+    return regrava(m, escala, &alfa);
+}
+
+/**
+ * @brief Aplica `f` a cada elemento armazenado de m, no lugar.
+ *
+ * Só os elementos armazenados são visitados (supõe-se f(0) == 0); os que
+ * passam a valer 0.0 são removidos. O índice por linha, se ligado, é mantido.
+ *
+ * @param m Ponteiro para a matriz.
+ * @param f Função aplicada a cada elemento (recebe valor, i e j com base 1, e `dados`).
+ * @param dados Ponteiro repassado a f.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m`/`f` forem NULL ou se falhar a reconstrução do índice (o índice é desligado).
+ */
+int matrix_apply(Matrix *m, FuncaoElemento f, void *dados) {
+    if (!m || !m->mat || !f) return 1;
+    return regrava(m, f, dados);
+}
+
+/**
+ * @brief Remove de m os elementos com |valor| < limiar, no lugar.
+ *
+ * @param m Ponteiro para a matriz.
+ * @param limiar Limiar de corte (limiar <= 0 não remove nada).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m` for NULL ou se falhar a reconstrução do índice (o índice é desligado).
+ */
+int matrix_drop(Matrix *m, float limiar) {
+    if (!m || !m->mat) return 1;
+    return regrava(m, corta, &limiar);
+}
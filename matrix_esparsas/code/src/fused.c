@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include "fused.h"
+#include "create.h"
+#include "math.h"
+#include "pool.h"
+#include "indice.h"
+
+/*
+ * Operações compostas calculadas linha a linha, direto no resultado, sem
+ * matrizes intermediárias: cada linha é acumulada em um Acumulador (o mesmo
+ * de matrix_multiply) e gravada uma única vez com acumulador_emite.
+ */
+
+static void acumula(Acumulador *a, int i, int j, double v, int *ntoc) {
+    if (a->marca[j] != i) {
+        a->marca[j] = i;
+        a->tocadas[(*ntoc)++] = j;
+    }
+    a->acc[j] += v;
+}
+
+/**
+ * @brief Calcula C = alfa * A * B + beta * C, no lugar, sem montar A * B.
+ *
+ * Para cada linha i, as contribuições de alfa * A(i, :) * B e de beta * C(i, :)
+ * são acumuladas juntas (em double) e a linha de C é regravada uma única vez.
+ * Os nós antigos da linha voltam ao alocador de C antes da gravação e são
+ * reaproveitados por ela. Com beta == 0, C não é lido (como na GEMM densa).
+ * Se o índice por linha de C estiver ligado, ele é mantido.
+ *
+ * @param alfa Escalar que multiplica A * B.
+ * @param a Ponteiro constante para A (m x p).
+ * @param b Ponteiro constante para B (p x q).
+ * @param beta Escalar que multiplica C.
+ * @param c Ponteiro para C (m x q), sobrescrita com o resultado.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis,
+ *         se C for a mesma matriz que A ou B, ou se falhar alguma alocação
+ *         (nesse caso o índice por linha de C é desligado).
+ * @return 2 se `a` contiver uma coluna fora dos limites de `b`.
+ *
+ * @post Em erro durante o cálculo, as linhas de C anteriores à que falhou já
+ *       foram atualizadas.
+ */
+int matrix_gemm(float alfa, const Matrix *a, const Matrix *b, float beta, Matrix *c) {
+    if (!a || !b || !c) return 1;
+    if (!a->mat || !b->mat || !c->mat) return 1;
+    if (a->colunas != b->linhas || c->linhas != a->linhas || c->colunas != b->colunas) return 1;
+    if (c == a || c == b) return 1;
+
+    Acumulador ac;
+    if (acumulador_init(&ac, c->colunas)) return 1;
+
+    int erro = 0;
+    for (int i = 0; i < c->linhas && !erro; i++) {
+        int ntoc = 0;
+
+        if (alfa != 0.0f) {
+            for (POINT pa = a->mat[i]; pa && !erro; pa = pa->prox) {
+                int k = pa->coluna;
+                if (k < 1 || k > b->linhas) {
+                    erro = 2;
+                    break;
+                }
+                double va = (double)alfa * pa->valor;
+                for (POINT pb = b->mat[k - 1]; pb; pb = pb->prox) {
+                    acumula(&ac, i, pb->coluna - 1, va * pb->valor, &ntoc);
+                }
+            }
+        }
+
+        POINT velho = c->mat[i];
+        if (beta != 0.0f) {
+            for (POINT pc = velho; pc; pc = pc->prox) {
+                acumula(&ac, i, pc->coluna - 1, (double)beta * pc->valor, &ntoc);
+            }
+        }
+
+        if (erro) {
+            acumulador_emite(&ac, i, ntoc, NULL, NULL);
+            break;
+        }
+
+        while (velho) {
+            POINT prox = velho->prox;
+            pool_free(&c->pool, velho);
+            velho = prox;
+        }
+        c->mat[i] = NULL;
+
+        erro = acumulador_emite(&ac, i, ntoc, &c->pool, &c->mat[i]);
+        if (c->indice && indice_reconstroi_linha(c, i)) erro = 1;
+    }
+
+    if (erro == 1) matrix_index_disable(c);
+    acumulador_free(&ac);
+    return erro;
+}
+
+/**
+ * @brief Calcula Aᵀ * B sem montar a transposta de A.
+ *
+ * A linha i do resultado precisa da coluna i de A. Cada linha k de A tem um
+ * cursor para o próximo nó ainda não usado, e os cursores ficam em baldes pela
+ * coluna para onde apontam. Ao processar a linha i, o balde i lista exatamente
+ * as linhas k com A(k, i) != 0: cada uma contribui A(k, i) * B(k, :) e seu
+ * cursor avança para o balde da próxima coluna. Como as listas são ordenadas,
+ * cada nó de A é visitado uma vez, com memória extra O(linhas + colunas) de A.
+ *
+ * @param a Ponteiro constante para A (p x m).
+ * @param b Ponteiro constante para B (p x q).
+ * @param r Endereço de ponteiro que receberá Aᵀ * B (m x q).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a->linhas != b->linhas
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_multiply_tn(const Matrix *a, const Matrix *b, Matrix **r) {
+    if (!a || !b || !r) return 1;
+    if (!a->mat || !b->mat) return 1;
+    if (a->linhas != b->linhas) return 1;
+    *r = NULL;
+
+    int p = a->linhas;
+    int m = a->colunas;
+
+    Matrix *res = init_matrix(m, b->colunas);
+    int *balde = (int*)malloc((size_t)m * sizeof(int));
+    int *seguinte = (int*)malloc((size_t)p * sizeof(int));
+    POINT *cursor = (POINT*)malloc((size_t)p * sizeof(POINT));
+    Acumulador ac;
+    int erro = acumulador_init(&ac, b->colunas);
+
+    if (!res || !balde || !seguinte || !cursor || erro) {
+        erro = 1;
+    } else {
+        for (int j = 0; j < m; j++) balde[j] = -1;
+        for (int k = p - 1; k >= 0; k--) {
+            cursor[k] = a->mat[k];
+            if (!cursor[k]) continue;
+            int j = cursor[k]->coluna - 1;
+            seguinte[k] = balde[j];
+            balde[j] = k;
+        }
+
+        for (int i = 0; i < m && !erro; i++) {
+            int ntoc = 0;
+            int k = balde[i];
+
+            while (k != -1) {
+                int prox_k = seguinte[k];
+                POINT pa = cursor[k];
+                double va = pa->valor;
+
+                for (POINT pb = b->mat[k]; pb; pb = pb->prox) {
+                    acumula(&ac, i, pb->coluna - 1, va * pb->valor, &ntoc);
+                }
+
+                cursor[k] = pa->prox;
+                if (cursor[k]) {
+                    int j = cursor[k]->coluna - 1;
+                    seguinte[k] = balde[j];
+                    balde[j] = k;
+                }
+                k = prox_k;
+            }
+
+            if (pool_reserve(&res->pool, ntoc)) erro = 1;
+            int e = acumulador_emite(&ac, i, ntoc, erro ? NULL : &res->pool, &res->mat[i]);
+            if (!erro) erro = e;
+        }
+    }
+
+    acumulador_free(&ac);
+    free(balde);
+    free(seguinte);
+    free(cursor);
+
+    if (erro) {
+        matrix_destroy(res);
+        return erro;
+    }
+
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Calcula a combinação linear coef[0] * ms[0] + ... + coef[n - 1] * ms[n - 1].
+ *
+ * Cada linha do resultado é acumulada a partir das n matrizes de uma vez e
+ * gravada uma única vez, sem as n - 2 matrizes intermediárias de uma cadeia de
+ * `matrix_add`. Somas que resultarem em 0.0 não são armazenadas.
+ *
+ * @param ms Vetor com n ponteiros para matrizes de mesmas dimensões.
+ * @param coef Coeficientes de cada matriz, ou NULL para somar todas com coeficiente 1.
+ * @param n Número de matrizes (>= 1).
+ * @param r Endereço de ponteiro que receberá o resultado.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se n < 1, se as dimensões forem
+ *         diferentes ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_add_n(const Matrix *const *ms, const float *coef, int n, Matrix **r) {
+    if (!ms || !r || n < 1) return 1;
+    *r = NULL;
+
+    for (int t = 0; t < n; t++) {
+        if (!ms[t] || !ms[t]->mat) return 1;
+        if (ms[t]->linhas != ms[0]->linhas || ms[t]->colunas != ms[0]->colunas) return 1;
+    }
+
+    Matrix *res = init_matrix(ms[0]->linhas, ms[0]->colunas);
+    if (!res) return 1;
+
+    Acumulador ac;
+    if (acumulador_init(&ac, res->colunas)) {
+        matrix_destroy(res);
+        return 1;
+    }
+
+    int erro = 0;
+    for (int i = 0; i < res->linhas && !erro; i++) {
+        int ntoc = 0;
+        for (int t = 0; t < n; t++) {
+            double c = coef ? coef[t] : 1.0;
+            for (POINT p = ms[t]->mat[i]; p; p = p->prox) {
+                acumula(&ac, i, p->coluna - 1, c * p->valor, &ntoc);
+            }
+        }
+
+        if (pool_reserve(&res->pool, ntoc)) erro = 1;
+        int e = acumulador_emite(&ac, i, ntoc, erro ? NULL : &res->pool, &res->mat[i]);
+        if (!erro) erro = e;
+    }
+
+    acumulador_free(&ac);
+    if (erro) {
+        matrix_destroy(res);
+        return erro;
+    }
+
+    *r = res;
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include "generators.h"
+#include "coo.h"
+
+/* Triplas acumuladas antes de montar a matriz com matrix_from_coo. */
+typedef struct Triplas {
+    int *is;
+    int *js;
+    float *vs;
+    int n;
+    int cap;
+} Triplas;
+
+static int triplas_add(Triplas *t, int i, int j, float v) {
+    if (t->n == t->cap) {
+        int cap = t->cap ? 2 * t->cap : 1024;
+        int *is = (int*)realloc(t->is, (size_t)cap * sizeof(int));
+        if (is) t->is = is;
+        int *js = (int*)realloc(t->js, (size_t)cap * sizeof(int));
+        if (js) t->js = js;
+        float *vs = (float*)realloc(t->vs, (size_t)cap * sizeof(float));
+        if (vs) t->vs = vs;
+        if (!is || !js || !vs) return 1;
+        t->cap = cap;
+    }
+    t->is[t->n] = i;
+    t->js[t->n] = j;
+    t->vs[t->n] = v;
+    t->n++;
+    return 0;
+}
+
+static int triplas_fim(Triplas *t, int erro, int linhas, int colunas, Matrix **r) {
+    if (!erro) erro = matrix_from_coo(linhas, colunas, t->is, t->js, t->vs, t->n, r);
+    free(t->is);
+    free(t->js);
+    free(t->vs);
+    return erro;
+}
+
+/* xorshift64*: reprodutível entre plataformas para a mesma semente. */
+static unsigned long long aleatorio(unsigned long long *s) {
+    unsigned long long x = *s;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *s = x;
+    return x * 2685821657736338717ULL;
+}
+
+static unsigned long long semeia(unsigned semente) {
+    return ((unsigned long long)semente << 1) * 0x9E3779B97F4A7C15ULL + 1;
+}
+
+/* Valor em [-1, 1), nunca 0. */
+static float valor_aleatorio(unsigned long long *s) {
+    float v = (float)(aleatorio(s) >> 40) / 16777216.0f * 2.0f - 1.0f;
+    return v != 0.0f ? v : 0.5f;
+}
+
+static double uniforme01(unsigned long long *s) {
+    return (double)(aleatorio(s) >> 11) / 9007199254740992.0;
+}
+
+/**
+ * @brief Gera uma matriz com elementos em posições uniformemente aleatórias.
+ *
+ * Cada linha recebe, em média, densidade * colunas elementos em colunas
+ * sorteadas; posições sorteadas mais de uma vez têm os valores somados.
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ * @param densidade Fração de elementos não nulos (0 a 1).
+ * @param semente Semente do gerador pseudoaleatório.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum parâmetro for inválido ou se falhar alguma alocação.
+ */
+int generate_uniform(int linhas, int colunas, double densidade, unsigned semente, Matrix **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (densidade < 0.0 || densidade > 1.0) return 1;
+
+    Triplas t = {0};
+    unsigned long long s = semeia(semente);
+    double media = densidade * colunas;
+    int erro = 0;
+
+    for (int i = 1; i <= linhas && !erro; i++) {
+        int k = (int)media;
+        if (uniforme01(&s) < media - k) k++;
+        while (k-- > 0 && !erro) {
+            int j = (int)(aleatorio(&s) % (unsigned long long)colunas) + 1;
+            erro = triplas_add(&t, i, j, valor_aleatorio(&s));
+        }
+    }
+    return triplas_fim(&t, erro, linhas, colunas, r);
+}
+
+/**
+ * @brief Gera uma matriz quadrada em banda, com todos os elementos |i - j| <= banda preenchidos.
+ *
+ * @param n Ordem da matriz (> 0).
+ * @param banda Meia largura da banda (>= 0).
+ * @param semente Semente do gerador pseudoaleatório.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum parâmetro for inválido ou se falhar alguma alocação.
+ */
+int generate_banded(int n, int banda, unsigned semente, Matrix **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (banda < 0) return 1;
+
+    Triplas t = {0};
+    unsigned long long s = semeia(semente);
+    int erro = 0;
+
+    for (int i = 1; i <= n && !erro; i++) {
+        int j0 = i - banda < 1 ? 1 : i - banda;
+        int j1 = i + banda > n ? n : i + banda;
+        for (int j = j0; j <= j1 && !erro; j++) erro = triplas_add(&t, i, j, valor_aleatorio(&s));
+    }
+    return triplas_fim(&t, erro, n, n, r);
+}
+
+/**
+ * @brief Gera uma matriz com número de elementos por linha em lei de potência.
+ *
+ * A linha de posto p (sorteado) recebe cerca de grau_max / (p + 1) elementos
+ * (distribuição de Zipf), em colunas uniformemente aleatórias: poucas linhas
+ * muito cheias e muitas linhas quase vazias, como em grafos reais.
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ * @param grau_max Elementos da linha mais cheia (> 0).
+ * @param semente Semente do gerador pseudoaleatório.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum parâmetro for inválido ou se falhar alguma alocação.
+ */
+int generate_powerlaw(int linhas, int colunas, int grau_max, unsigned semente, Matrix **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (linhas <= 0 || grau_max <= 0) return 1;
+
+    int *posto = (int*)malloc((size_t)linhas * sizeof(int));
+    if (!posto) return 1;
+
+    unsigned long long s = semeia(semente);
+    for (int i = 0; i < linhas; i++) posto[i] = i;
+    for (int i = linhas - 1; i > 0; i--) {
+        int k = (int)(aleatorio(&s) % (unsigned long long)(i + 1));
+        int tmp = posto[i];
+        posto[i] = posto[k];
+        posto[k] = tmp;
+    }
+
+    Triplas t = {0};
+    int erro = 0;
+    for (int i = 1; i <= linhas && !erro; i++) {
+        int k = grau_max / (posto[i - 1] + 1);
+        if (k < 1) k = 1;
+        if (k > colunas) k = colunas;
+        while (k-- > 0 && !erro) {
+            int j = (int)(aleatorio(&s) % (unsigned long long)colunas) + 1;
+            erro = triplas_add(&t, i, j, valor_aleatorio(&s));
+        }
+    }
+
+    free(posto);
+    return triplas_fim(&t, erro, linhas, colunas, r);
+}
+
+/**
+ * @brief Gera uma matriz bloco-diagonal com blocos quadrados preenchidos aleatoriamente.
+ *
+ * @param nblocos Número de blocos na diagonal (> 0).
+ * @param tam_bloco Ordem de cada bloco (> 0).
+ * @param densidade Fração de elementos não nulos dentro de cada bloco (0 a 1).
+ * @param semente Semente do gerador pseudoaleatório.
+ * @param r Endereço de ponteiro que receberá a matriz (nblocos * tam_bloco quadrada).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum parâmetro for inválido ou se falhar alguma alocação.
+ */
+int generate_block_diagonal(int nblocos, int tam_bloco, double densidade, unsigned semente, Matrix **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (nblocos <= 0 || tam_bloco <= 0 || densidade < 0.0 || densidade > 1.0) return 1;
+
+    Triplas t = {0};
+    unsigned long long s = semeia(semente);
+    int erro = 0;
+
+    for (int b = 0; b < nblocos && !erro; b++) {
+        int base = b * tam_bloco;
+        for (int i = 1; i <= tam_bloco && !erro; i++) {
+            for (int j = 1; j <= tam_bloco && !erro; j++) {
+                if (uniforme01(&s) < densidade) erro = triplas_add(&t, base + i, base + j, valor_aleatorio(&s));
+            }
+        }
+    }
+    return triplas_fim(&t, erro, nblocos * tam_bloco, nblocos * tam_bloco, r);
+}
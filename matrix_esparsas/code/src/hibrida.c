@@ -0,0 +1,653 @@
+#include <stdlib.h>
+#include <string.h>
+#include "hibrida.h"
+#include "create.h"
+#include "pool.h"
+#include "math.h"
+
+/* Palavras de 64 bits do bitmap de uma linha densa. */
+#define PALAVRAS(colunas) (((size_t)(colunas) + 63) / 64)
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int deve_ser_densa(int nnz, int colunas) {
+    return (long long)nnz * 100 >= (long long)colunas * HIBRIDA_DENSA_PCT;
+}
+
+static int deve_ser_esparsa(int nnz, int colunas) {
+    return (long long)nnz * 100 < (long long)colunas * HIBRIDA_ESPARSA_PCT;
+}
+
+static void linha_libera(LinhaHibrida *l) {
+    free(l->col_idx);
+    free(l->values);
+    free(l->bits);
+    memset(l, 0, sizeof(*l));
+}
+
+/* Converte uma linha esparsa para a forma densa; se faltar memória, a linha não muda. */
+static int linha_para_densa(LinhaHibrida *l, int colunas) {
+    float *values = (float*)calloc((size_t)colunas, sizeof(float));
+    uint64_t *bits = (uint64_t*)calloc(PALAVRAS(colunas), sizeof(uint64_t));
+    if (!values || !bits) {
+        free(values);
+        free(bits);
+        return 1;
+    }
+
+    for (int t = 0; t < l->nnz; t++) {
+        int j = l->col_idx[t];
+        values[j] = l->values[t];
+        bits[j >> 6] |= 1ULL << (j & 63);
+    }
+
+    free(l->col_idx);
+    free(l->values);
+    l->col_idx = NULL;
+    l->values = values;
+    l->bits = bits;
+    l->cap = 0;
+    l->densa = 1;
+    return 0;
+}
+
+/* Converte uma linha densa para a forma esparsa; se faltar memória, a linha não muda. */
+static int linha_para_esparsa(LinhaHibrida *l, int colunas) {
+    int cap = l->nnz ? l->nnz : 1;
+    int *col_idx = (int*)malloc((size_t)cap * sizeof(int));
+    float *values = (float*)malloc((size_t)cap * sizeof(float));
+    if (!col_idx || !values) {
+        free(col_idx);
+        free(values);
+        return 1;
+    }
+
+    int t = 0;
+    for (size_t w = 0; w < PALAVRAS(colunas); w++) {
+        for (uint64_t b = l->bits[w]; b; b &= b - 1) {
+            int j = (int)(w * 64) + __builtin_ctzll(b);
+            col_idx[t] = j;
+            values[t++] = l->values[j];
+        }
+    }
+
+    free(l->values);
+    free(l->bits);
+    l->col_idx = col_idx;
+    l->values = values;
+    l->bits = NULL;
+    l->cap = cap;
+    l->densa = 0;
+    return 0;
+}
+
+/*
+ * Escolhe a forma da linha pela ocupação. Não conseguir trocar de forma por
+ * falta de memória não é erro: a linha continua válida na forma atual.
+ */
+static void linha_ajusta(LinhaHibrida *l, int colunas) {
+    if (!l->densa && deve_ser_densa(l->nnz, colunas)) linha_para_densa(l, colunas);
+    else if (l->densa && deve_ser_esparsa(l->nnz, colunas)) linha_para_esparsa(l, colunas);
+}
+
+/* Primeira posição da linha esparsa com coluna >= j. */
+static int linha_busca(const LinhaHibrida *l, int j) {
+    int ini = 0, fim = l->nnz;
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        if (l->col_idx[meio] < j) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini;
+}
+
+static float linha_le(const LinhaHibrida *l, int j) {
+    if (l->densa) return l->values[j];
+
+    int p = linha_busca(l, j);
+    return (p < l->nnz && l->col_idx[p] == j) ? l->values[p] : 0.0f;
+}
+
+static int linha_cresce(LinhaHibrida *l) {
+    if (l->nnz < l->cap) return 0;
+
+    int cap = l->cap ? 2 * l->cap : 4;
+    int *col_idx = (int*)realloc(l->col_idx, (size_t)cap * sizeof(int));
+    if (!col_idx) return 1;
+    l->col_idx = col_idx;
+
+    float *values = (float*)realloc(l->values, (size_t)cap * sizeof(float));
+    if (!values) return 1;
+    l->values = values;
+
+    l->cap = cap;
+    return 0;
+}
+
+/* Grava valor na coluna j (base 0) da linha; 0.0 remove o elemento. */
+static int linha_grava(LinhaHibrida *l, int colunas, int j, float valor) {
+    if (l->densa) {
+        uint64_t bit = 1ULL << (j & 63);
+        int presente = (l->bits[j >> 6] & bit) != 0;
+
+        if (valor == 0.0f && presente) {
+            l->bits[j >> 6] &= ~bit;
+            l->nnz--;
+        } else if (valor != 0.0f && !presente) {
+            l->bits[j >> 6] |= bit;
+            l->nnz++;
+        }
+        l->values[j] = valor;
+    } else {
+        int p = linha_busca(l, j);
+        int existe = p < l->nnz && l->col_idx[p] == j;
+
+        if (existe && valor == 0.0f) {
+            memmove(l->col_idx + p, l->col_idx + p + 1, (size_t)(l->nnz - p - 1) * sizeof(int));
+            memmove(l->values + p, l->values + p + 1, (size_t)(l->nnz - p - 1) * sizeof(float));
+            l->nnz--;
+        } else if (existe) {
+            l->values[p] = valor;
+        } else if (valor != 0.0f) {
+            if (linha_cresce(l)) return 1;
+            memmove(l->col_idx + p + 1, l->col_idx + p, (size_t)(l->nnz - p) * sizeof(int));
+            memmove(l->values + p + 1, l->values + p, (size_t)(l->nnz - p) * sizeof(float));
+            l->col_idx[p] = j;
+            l->values[p] = valor;
+            l->nnz++;
+        }
+    }
+
+    linha_ajusta(l, colunas);
+    return 0;
+}
+
+/**
+ * @brief Inicializa uma matriz híbrida vazia (todas as linhas na forma esparsa).
+ *
+ * @param linhas Número de linhas (> 0).
+ * @param colunas Número de colunas (> 0).
+ *
+ * @return Ponteiro para a matriz alocada em caso de sucesso.
+ * @return NULL se os parâmetros forem inválidos ou se falhar alguma alocação.
+ */
+MatrixHibrida* hibrida_init(int linhas, int colunas) {
+    if (linhas <= 0 || colunas <= 0) return NULL;
+
+    MatrixHibrida *h = (MatrixHibrida*)malloc(sizeof(MatrixHibrida));
+    if (!h) return NULL;
+
+    h->linhas = linhas;
+    h->colunas = colunas;
+    h->rows = (LinhaHibrida*)calloc((size_t)linhas, sizeof(LinhaHibrida));
+    if (!h->rows) {
+        free(h);
+        return NULL;
+    }
+    return h;
+}
+
+/**
+ * @brief Libera toda a memória associada a uma matriz híbrida.
+ *
+ * @param h Ponteiro para a matriz a ser destruída.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `h` for NULL.
+ */
+int hibrida_destroy(MatrixHibrida *h) {
+    if (!h) return 1;
+
+    for (int i = 0; i < h->linhas; i++) linha_libera(&h->rows[i]);
+    free(h->rows);
+    free(h);
+    return 0;
+}
+
+/**
+ * @brief Converte uma matriz em listas encadeadas para a representação híbrida.
+ *
+ * Cada linha é copiada para vetores ordenados e passa para a forma densa se
+ * ocupar pelo menos HIBRIDA_DENSA_PCT% das colunas.
+ *
+ * @param m Ponteiro constante para a matriz de origem.
+ * @param r Endereço de ponteiro que receberá a matriz híbrida.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int hibrida_from_matrix(const Matrix *m, MatrixHibrida **r) {
+    if (!m || !m->mat || !r) return 1;
+    *r = NULL;
+
+    MatrixHibrida *h = hibrida_init(m->linhas, m->colunas);
+    if (!h) return 1;
+
+    for (int i = 0; i < m->linhas; i++) {
+        LinhaHibrida *l = &h->rows[i];
+        int n = 0;
+        for (POINT p = m->mat[i]; p; p = p->prox) n++;
+        if (!n) continue;
+
+        l->col_idx = (int*)malloc((size_t)n * sizeof(int));
+        l->values = (float*)malloc((size_t)n * sizeof(float));
+        if (!l->col_idx || !l->values) {
+            hibrida_destroy(h);
+            return 1;
+        }
+        l->cap = n;
+
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            if (p->valor == 0.0f) continue;
+            l->col_idx[l->nnz] = p->coluna - 1;
+            l->values[l->nnz++] = p->valor;
+        }
+        linha_ajusta(l, m->colunas);
+    }
+
+    *r = h;
+    return 0;
+}
+
+/* Anexa (j + 1, v) ao fim de uma lista, em *cauda. */
+static int anexa(NoPool *pool, POINT **cauda, int j, float v) {
+    No *novo = pool_alloc(pool);
+    if (!novo) return 1;
+
+    novo->coluna = j + 1;
+    novo->valor = v;
+    novo->prox = NULL;
+    **cauda = novo;
+    *cauda = &novo->prox;
+    return 0;
+}
+
+/**
+ * @brief Converte uma matriz híbrida para a representação em listas encadeadas.
+ *
+ * @param h Ponteiro constante para a matriz híbrida.
+ * @param r Endereço de ponteiro que receberá a nova matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `h`/`r` forem NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int hibrida_to_matrix(const MatrixHibrida *h, Matrix **r) {
+    if (!h || !r) return 1;
+    *r = NULL;
+
+    Matrix *res = init_matrix(h->linhas, h->colunas);
+    if (!res) return 1;
+
+    long long nnz = 0;
+    for (int i = 0; i < h->linhas; i++) nnz += h->rows[i].nnz;
+    if (nnz > INT32_MAX || pool_reserve(&res->pool, (int)nnz)) {
+        matrix_destroy(res);
+        return 1;
+    }
+
+    int erro = 0;
+    for (int i = 0; i < h->linhas && !erro; i++) {
+        const LinhaHibrida *l = &h->rows[i];
+        POINT *cauda = &res->mat[i];
+
+        if (l->densa) {
+            for (size_t w = 0; w < PALAVRAS(h->colunas) && !erro; w++) {
+                for (uint64_t b = l->bits[w]; b && !erro; b &= b - 1) {
+                    int j = (int)(w * 64) + __builtin_ctzll(b);
+                    erro = anexa(&res->pool, &cauda, j, l->values[j]);
+                }
+            }
+        } else {
+            for (int t = 0; t < l->nnz && !erro; t++) erro = anexa(&res->pool, &cauda, l->col_idx[t], l->values[t]);
+        }
+    }
+
+    if (erro) {
+        matrix_destroy(res);
+        return erro;
+    }
+
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Obtém o valor de um elemento da matriz híbrida.
+ *
+ * Em linhas densas o acesso é direto; nas esparsas, por busca binária.
+ * Os índices i e j seguem indexação iniciando em 1.
+ *
+ * @param h Ponteiro constante para a matriz.
+ * @param i Índice da linha (1 ≤ i ≤ h->linhas).
+ * @param j Índice da coluna (1 ≤ j ≤ h->colunas).
+ * @param elem Ponteiro para armazenar o valor (0.0 se o elemento não existir).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `h`/`elem` forem NULL ou se os índices estiverem fora dos limites.
+ */
+int hibrida_getelem(const MatrixHibrida *h, int i, int j, float *elem) {
+    if (!h || !elem) return 1;
+    if (i < 1 || i > h->linhas) return 1;
+    if (j < 1 || j > h->colunas) return 1;
+
+    *elem = linha_le(&h->rows[i - 1], j - 1);
+    return 0;
+}
+
+/**
+ * @brief Insere, atualiza ou remove (valor 0.0) um elemento da matriz híbrida.
+ *
+ * Depois da alteração, a linha muda de forma se a ocupação cruzar
+ * HIBRIDA_DENSA_PCT (para densa) ou HIBRIDA_ESPARSA_PCT (para esparsa).
+ *
+ * @param h Ponteiro para a matriz.
+ * @param i Índice da linha (1 ≤ i ≤ h->linhas).
+ * @param j Índice da coluna (1 ≤ j ≤ h->colunas).
+ * @param valor Valor a ser gravado (0.0 remove o elemento).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `h` for NULL, se os índices estiverem fora dos limites ou se
+ *         falhar uma alocação (a matriz não é alterada).
+ */
+int hibrida_setelem(MatrixHibrida *h, int i, int j, float valor) {
+    if (!h) return 1;
+    if (i < 1 || i > h->linhas) return 1;
+    if (j < 1 || j > h->colunas) return 1;
+
+    return linha_grava(&h->rows[i - 1], h->colunas, j - 1, valor);
+}
+
+/**
+ * @brief Soma `delta` ao elemento (i, j) da matriz híbrida, como `matrix_addelem`.
+ *
+ * Se o resultado for 0.0, o elemento é removido. A linha muda de forma como
+ * em `hibrida_setelem`.
+ *
+ * @param h Ponteiro para a matriz.
+ * @param i Índice da linha (1 ≤ i ≤ h->linhas).
+ * @param j Índice da coluna (1 ≤ j ≤ h->colunas).
+ * @param delta Incremento (0.0 não altera a matriz).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `h` for NULL, se os índices estiverem fora dos limites ou se
+ *         falhar uma alocação (a matriz não é alterada).
+ */
+int hibrida_addelem(MatrixHibrida *h, int i, int j, float delta) {
+    if (!h) return 1;
+    if (i < 1 || i > h->linhas) return 1;
+    if (j < 1 || j > h->colunas) return 1;
+    if (delta == 0.0f) return 0;
+
+    LinhaHibrida *l = &h->rows[i - 1];
+    return linha_grava(l, h->colunas, j - 1, linha_le(l, j - 1) + delta);
+}
+
+/**
+ * @brief Conta as linhas que estão na forma densa.
+ *
+ * @param h Ponteiro constante para a matriz.
+ *
+ * @return O número de linhas densas (0 se `h` for NULL).
+ */
+int hibrida_linhas_densas(const MatrixHibrida *h) {
+    if (!h) return 0;
+
+    int n = 0;
+    for (int i = 0; i < h->linhas; i++) n += h->rows[i].densa;
+    return n;
+}
+
+/*
+ * r = a + b para uma linha. Com as duas esparsas, intercala os vetores
+ * ordenados; com alguma densa, soma no vetor denso (laço contínuo quando as
+ * duas são densas) e refaz o bitmap a partir dos valores, descartando os
+ * cancelamentos.
+ */
+static int linha_soma(const LinhaHibrida *a, const LinhaHibrida *b, int colunas, LinhaHibrida *r) {
+    if (!a->densa && !b->densa) {
+        int cap = a->nnz + b->nnz;
+        if (!cap) return 0;
+
+        r->col_idx = (int*)malloc((size_t)cap * sizeof(int));
+        r->values = (float*)malloc((size_t)cap * sizeof(float));
+        if (!r->col_idx || !r->values) return 1;
+        r->cap = cap;
+
+        int pa = 0, pb = 0, t = 0;
+        while (pa < a->nnz || pb < b->nnz) {
+            int col;
+            float val;
+
+            if (pb == b->nnz || (pa < a->nnz && a->col_idx[pa] < b->col_idx[pb])) {
+                col = a->col_idx[pa];
+                val = a->values[pa++];
+            } else if (pa == a->nnz || b->col_idx[pb] < a->col_idx[pa]) {
+                col = b->col_idx[pb];
+                val = b->values[pb++];
+            } else {
+                col = a->col_idx[pa];
+                val = a->values[pa++] + b->values[pb++];
+            }
+
+            if (val != 0.0f) {
+                r->col_idx[t] = col;
+                r->values[t++] = val;
+            }
+        }
+        r->nnz = t;
+    } else {
+        const LinhaHibrida *d = a->densa ? a : b;
+        const LinhaHibrida *o = (d == a) ? b : a;
+
+        r->values = (float*)malloc((size_t)colunas * sizeof(float));
+        r->bits = (uint64_t*)malloc(PALAVRAS(colunas) * sizeof(uint64_t));
+        if (!r->values || !r->bits) return 1;
+        r->densa = 1;
+
+        if (o->densa) {
+            for (int j = 0; j < colunas; j++) r->values[j] = d->values[j] + o->values[j];
+        } else {
+            memcpy(r->values, d->values, (size_t)colunas * sizeof(float));
+            for (int t = 0; t < o->nnz; t++) r->values[o->col_idx[t]] += o->values[t];
+        }
+
+        int nnz = 0;
+        for (size_t w = 0; w < PALAVRAS(colunas); w++) {
+            uint64_t palavra = 0;
+            int j0 = (int)(w * 64);
+            int j1 = j0 + 64 < colunas ? j0 + 64 : colunas;
+            for (int j = j0; j < j1; j++) palavra |= (uint64_t)(r->values[j] != 0.0f) << (j - j0);
+            r->bits[w] = palavra;
+            nnz += __builtin_popcountll(palavra);
+        }
+        r->nnz = nnz;
+    }
+
+    linha_ajusta(r, colunas);
+    return 0;
+}
+
+/**
+ * @brief Calcula a soma de duas matrizes híbridas de mesmas dimensões.
+ *
+ * Cada linha do resultado é montada pelo caminho da combinação de formas das
+ * linhas de `a` e `b` (esparsa + esparsa, densa + esparsa, densa + densa) e
+ * fica na forma adequada à sua ocupação. Elementos que resultem em 0.0 não
+ * são armazenados.
+ *
+ * @param a Ponteiro constante para a primeira matriz.
+ * @param b Ponteiro constante para a segunda matriz.
+ * @param r Endereço de ponteiro que receberá a matriz resultante.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int hibrida_add(const MatrixHibrida *a, const MatrixHibrida *b, MatrixHibrida **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (!a || !b) return 1;
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 1;
+
+    MatrixHibrida *res = hibrida_init(a->linhas, a->colunas);
+    if (!res) return 1;
+
+    for (int i = 0; i < a->linhas; i++) {
+        if (linha_soma(&a->rows[i], &b->rows[i], a->colunas, &res->rows[i])) {
+            hibrida_destroy(res);
+            return 1;
+        }
+    }
+
+    *r = res;
+    return 0;
+}
+
+/*
+ * acc += aik * b(k, :). Uma linha densa de b entra como um laço contínuo sobre
+ * todas as colunas, sem marcação; a partir daí a linha de saída é tratada
+ * como densa (`*cheia`).
+ */
+static void acumula_linha(const LinhaHibrida *lb, int q, double aik, Acumulador *ac, int i, int *ntoc, int *cheia) {
+    if (lb->densa) {
+        const float *v = lb->values;
+        for (int j = 0; j < q; j++) ac->acc[j] += aik * v[j];
+        *cheia = 1;
+        return;
+    }
+
+    for (int t = 0; t < lb->nnz; t++) {
+        int j = lb->col_idx[t];
+        if (!*cheia && ac->marca[j] != i) {
+            ac->marca[j] = i;
+            ac->tocadas[(*ntoc)++] = j;
+        }
+        ac->acc[j] += aik * lb->values[t];
+    }
+}
+
+/*
+ * Linha i de a * b. Se a saída for densa (alguma linha densa de b ou colunas
+ * tocadas acima de HIBRIDA_DENSA_PCT), é gravada varrendo o acumulador em
+ * ordem, sem ordenar as colunas tocadas. O acumulador é deixado limpo.
+ */
+static int linha_produto(const MatrixHibrida *a, const MatrixHibrida *b, int i, Acumulador *ac, LinhaHibrida *r) {
+    const LinhaHibrida *la = &a->rows[i];
+    int q = b->colunas;
+    int ntoc = 0, cheia = 0;
+
+    if (la->densa) {
+        for (size_t w = 0; w < PALAVRAS(a->colunas); w++) {
+            for (uint64_t bits = la->bits[w]; bits; bits &= bits - 1) {
+                int k = (int)(w * 64) + __builtin_ctzll(bits);
+                acumula_linha(&b->rows[k], q, la->values[k], ac, i, &ntoc, &cheia);
+            }
+        }
+    } else {
+        for (int t = 0; t < la->nnz; t++) {
+            acumula_linha(&b->rows[la->col_idx[t]], q, la->values[t], ac, i, &ntoc, &cheia);
+        }
+    }
+
+    if (cheia || deve_ser_densa(ntoc, q)) {
+        r->values = (float*)calloc((size_t)q, sizeof(float));
+        r->bits = (uint64_t*)calloc(PALAVRAS(q), sizeof(uint64_t));
+        if (!r->values || !r->bits) {
+            if (cheia) memset(ac->acc, 0, (size_t)q * sizeof(double));
+            else for (int t = 0; t < ntoc; t++) ac->acc[ac->tocadas[t]] = 0.0;
+            return 1;
+        }
+        r->densa = 1;
+
+        for (int j = 0; j < q; j++) {
+            float v = (float)ac->acc[j];
+            ac->acc[j] = 0.0;
+            if (v != 0.0f) {
+                r->values[j] = v;
+                r->bits[j >> 6] |= 1ULL << (j & 63);
+                r->nnz++;
+            }
+        }
+    } else if (ntoc) {
+        qsort(ac->tocadas, (size_t)ntoc, sizeof(int), cmp_int);
+
+        r->col_idx = (int*)malloc((size_t)ntoc * sizeof(int));
+        r->values = (float*)malloc((size_t)ntoc * sizeof(float));
+        int falhou = !r->col_idx || !r->values;
+        if (!falhou) r->cap = ntoc;
+
+        for (int t = 0; t < ntoc; t++) {
+            int j = ac->tocadas[t];
+            float v = (float)ac->acc[j];
+            ac->acc[j] = 0.0;
+            if (!falhou && v != 0.0f) {
+                r->col_idx[r->nnz] = j;
+                r->values[r->nnz++] = v;
+            }
+        }
+        if (falhou) return 1;
+    }
+
+    linha_ajusta(r, q);
+    return 0;
+}
+
+/**
+ * @brief Calcula o produto de duas matrizes híbridas (Gustavson por linha).
+ *
+ * As linhas densas de `a` são percorridas pelo bitmap; cada linha densa de `b`
+ * referenciada é somada ao acumulador com um laço contínuo sobre as colunas
+ * (vetorizável), e a linha de saída correspondente é gravada na forma densa
+ * sem ordenar as colunas tocadas. Linhas esparsas seguem o caminho com
+ * marcação e ordenação, como em `matrix_multiply`, e o resultado é igual ao
+ * de `matrix_multiply` sobre as mesmas matrizes.
+ *
+ * @param a Ponteiro constante para a matriz à esquerda (m x p).
+ * @param b Ponteiro constante para a matriz à direita (p x q).
+ * @param r Endereço de ponteiro que receberá a matriz produto (m x q).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a->colunas != b->linhas
+ *         ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int hibrida_multiply(const MatrixHibrida *a, const MatrixHibrida *b, MatrixHibrida **r) {
+    if (!r) return 1;
+    *r = NULL;
+    if (!a || !b) return 1;
+    if (a->colunas != b->linhas) return 1;
+
+    MatrixHibrida *res = hibrida_init(a->linhas, b->colunas);
+    if (!res) return 1;
+
+    Acumulador ac;
+    if (acumulador_init(&ac, b->colunas)) {
+        hibrida_destroy(res);
+        return 1;
+    }
+
+    int erro = 0;
+    for (int i = 0; i < a->linhas && !erro; i++) {
+        erro = linha_produto(a, b, i, &ac, &res->rows[i]);
+    }
+    acumulador_free(&ac);
+
+    if (erro) {
+        hibrida_destroy(res);
+        return erro;
+    }
+
+    *r = res;
+    return 0;
+}
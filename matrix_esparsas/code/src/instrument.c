@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include "instrument.h"
+
+#ifdef MATRIX_INSTRUMENT
+#include <stdatomic.h>
+
+enum { C_CHAMADAS, C_NS, C_PASSOS, C_PRODUTOS, C_FLOPS, C_ALOCADOS, C_LIBERADOS, C_N };
+
+/* Atualizados com operações atômicas relaxadas: as versões paralelas somam de várias threads. */
+static _Atomic long long contadores[INSTR_NOPS][C_N];
+
+_Thread_local long long instr_passos_thread = 0;
+
+static void conta(InstrOp op, int c, long long v) {
+    if (v) atomic_fetch_add_explicit(&contadores[op][c], v, memory_order_relaxed);
+}
+
+/**
+ * @brief Soma passos, produtos parciais e flops de uma parte da operação `op`.
+ *
+ * Usado pelos núcleos por linha, que contam localmente e somam uma vez por linha.
+ * Não conta uma chamada.
+ */
+void instr_soma(InstrOp op, long long passos, long long produtos, long long flops) {
+    conta(op, C_PASSOS, passos);
+    conta(op, C_PRODUTOS, produtos);
+    conta(op, C_FLOPS, flops);
+}
+
+/**
+ * @brief Registra uma chamada concluída de `op`, com seu tempo de parede e contadores.
+ */
+void instr_registra(InstrOp op, long long ns, long long passos, long long produtos, long long flops,
+                    long long nos_alocados, long long nos_liberados) {
+    conta(op, C_CHAMADAS, 1);
+    conta(op, C_NS, ns);
+    instr_soma(op, passos, produtos, flops);
+    conta(op, C_ALOCADOS, nos_alocados);
+    conta(op, C_LIBERADOS, nos_liberados);
+}
+#endif
+
+/**
+ * @brief Indica se a biblioteca foi compilada com MATRIX_INSTRUMENT.
+ *
+ * @return 1 se os contadores estão ativos, 0 caso contrário.
+ */
+int instr_ativo(void) {
+#ifdef MATRIX_INSTRUMENT
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Nome de uma operação, como aparece no JSON.
+ *
+ * @return O nome, ou NULL se `op` for inválida.
+ */
+const char* instr_nome(InstrOp op) {
+    static const char *nomes[INSTR_NOPS] = { "add", "multiply", "transpose", "setelem" };
+    if (op < 0 || op >= INSTR_NOPS) return NULL;
+    return nomes[op];
+}
+
+/**
+ * @brief Zera todos os contadores.
+ *
+ * Não deve ser chamada enquanto alguma operação instrumentada estiver em andamento.
+ */
+void instr_zera(void) {
+#ifdef MATRIX_INSTRUMENT
+    for (int op = 0; op < INSTR_NOPS; op++) {
+        for (int c = 0; c < C_N; c++) atomic_store_explicit(&contadores[op][c], 0, memory_order_relaxed);
+    }
+#endif
+}
+
+/**
+ * @brief Lê os contadores acumulados de uma operação.
+ *
+ * Cobre `matrix_add`, `matrix_multiply`, `matrix_transpose` (e a versão em
+ * blocos) e `matrix_setelem`, inclusive as versões paralelas de soma e
+ * produto. Só chamadas concluídas com sucesso são contadas.
+ *
+ * @param op Operação.
+ * @param c Estrutura que recebe os contadores (todos zero sem MATRIX_INSTRUMENT).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `c` for NULL.
+ * @return 2 se `op` for inválida.
+ */
+int instr_le(InstrOp op, InstrContadores *c) {
+    if (!c) return 1;
+    if (op < 0 || op >= INSTR_NOPS) return 2;
+
+    *c = (InstrContadores){0};
+#ifdef MATRIX_INSTRUMENT
+    c->chamadas = atomic_load_explicit(&contadores[op][C_CHAMADAS], memory_order_relaxed);
+    c->ns = atomic_load_explicit(&contadores[op][C_NS], memory_order_relaxed);
+    c->passos = atomic_load_explicit(&contadores[op][C_PASSOS], memory_order_relaxed);
+    c->produtos = atomic_load_explicit(&contadores[op][C_PRODUTOS], memory_order_relaxed);
+    c->flops = atomic_load_explicit(&contadores[op][C_FLOPS], memory_order_relaxed);
+    c->nos_alocados = atomic_load_explicit(&contadores[op][C_ALOCADOS], memory_order_relaxed);
+    c->nos_liberados = atomic_load_explicit(&contadores[op][C_LIBERADOS], memory_order_relaxed);
+#endif
+    return 0;
+}
+
+/**
+ * @brief Escreve todos os contadores como um objeto JSON em uma linha.
+ *
+ * Formato: {"instrumentado":true,"add":{"chamadas":...,"ns":...,"passos":...,
+ * "produtos":...,"flops":...,"nos_alocados":...,"nos_liberados":...},"multiply":{...},...}
+ *
+ * @param f Arquivo de saída.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `f` for NULL ou se a escrita falhar.
+ */
+int instr_dump_json(FILE *f) {
+    if (!f) return 1;
+
+    int erro = fprintf(f, "{\"instrumentado\":%s", instr_ativo() ? "true" : "false") < 0;
+    for (int op = 0; op < INSTR_NOPS && !erro; op++) {
+        InstrContadores c;
+        instr_le((InstrOp)op, &c);
+        erro = fprintf(f, ",\"%s\":{\"chamadas\":%lld,\"ns\":%lld,\"passos\":%lld,\"produtos\":%lld,"
+                          "\"flops\":%lld,\"nos_alocados\":%lld,\"nos_liberados\":%lld}",
+                       instr_nome((InstrOp)op), c.chamadas, c.ns, c.passos, c.produtos,
+                       c.flops, c.nos_alocados, c.nos_liberados) < 0;
+    }
+    if (!erro) erro = fprintf(f, "}\n") < 0;
+    return erro;
+}
@@ -1,4 +1,5 @@
 #include "manipulate.h"
+#include "indice.h"
 #include <math.h>
 
 /**
@@ -7,7 +8,8 @@
  * Busca o elemento localizado na posição (x, y) da matriz esparsa.
  * Caso exista um nó correspondente na lista encadeada da linha x,
  * seu valor é retornado em `elem`. Caso contrário, o valor retornado
- * é 0.0, representando um elemento nulo da matriz.
+ * é 0.0, representando um elemento nulo da matriz. Com o índice por linha
+ * ligado, a busca é binária.
  *
  * As posições x e y seguem indexação iniciando em 1.
  *
@@ -31,11 +33,9 @@
     if (x < 1 || x > m->linhas) return 1;
     if (y < 1 || y > m->colunas) return 1;
 
-    POINT atual = m->mat[x - 1];
-
-    while (atual && atual->coluna < y) {
-        atual = atual->prox;
-    }
+    POINT anterior;
+    int pos;
+    POINT atual = linha_localiza(m, x - 1, y, &anterior, &pos);
 
     if (atual && atual->coluna == y) {
         *elem = atual->valor;
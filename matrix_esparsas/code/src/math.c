@@ -1,6 +1,9 @@
 #include <stdlib.h>
 #include "math.h"
 #include "create.h"
+#include "pool.h"
+#include "indice.h"
+#include "instrument.h"
 
 /**
  * @brief Soma um incremento (delta) ao elemento (i, j) de uma matriz esparsa.
@@ -31,47 +34,89 @@ int matrix_addelem(Matrix *m, int i, int j, float delta) {
     if (j < 1 || j > m->colunas) return 2;
 
     int linha = i - 1;
-    POINT anterior = NULL;
-    POINT atual = m->mat[linha];
-
-    while (atual && atual->coluna < j) {
-        anterior = atual;
-        atual = atual->prox;
-    }
+    POINT anterior;
+    int pos;
+    POINT atual = linha_localiza(m, linha, j, &anterior, &pos);
 
     if (atual && atual->coluna == j) {
         float nv = atual->valor + delta;
 
-        if (nv == 0.0f) {
-            if (anterior) anterior->prox = atual->prox;
-            else m->mat[linha] = atual->prox;
-            free(atual);
-            return 0;
-        }
-
-        atual->valor = nv;
+        if (nv == 0.0f) linha_remove(m, linha, anterior, atual, pos);
+        else atual->valor = nv;
         return 0;
     }
 
-    No *novo = (No*)malloc(sizeof(No));
-    if (!novo) return 1;
+    if (delta == 0.0f) return 0;
+
+    return linha_insere(m, linha, anterior, pos, j, delta);
+}
+
+
+/**
+ * @brief Monta a linha i de `m + n` em `*saida`.
+ *
+ * Percorre simultaneamente as listas (ordenadas por coluna) da linha i de `m` e `n`,
+ * anexando cada resultado não nulo ao final da lista de saída.
+ *
+ * @param m Ponteiro constante para a primeira matriz.
+ * @param n Ponteiro constante para a segunda matriz.
+ * @param i Índice da linha (base 0).
+ * @param pool Alocador de onde saem os nós da linha de saída.
+ * @param saida Endereço da cabeça da lista de saída (deve estar vazia).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se falhar a alocação de um nó (os nós já anexados permanecem em `*saida`).
+ */
+int matrix_add_row(const Matrix *m, const Matrix *n, int i, NoPool *pool, POINT *saida) {
+    POINT pm = m->mat[i];
+    POINT pn = n->mat[i];
+    POINT *cauda = saida;
+    INSTR_VAR(passos, 0);
+    INSTR_VAR(somas, 0);
+
+    while (pm || pn) {
+        int col;
+        float val;
+        INSTR_CONTA(passos, 1);
+
+        if (!pn || (pm && pm->coluna < pn->coluna)) {
+            col = pm->coluna;
+            val = pm->valor;
+            pm = pm->prox;
+        } else if (!pm || pn->coluna < pm->coluna) {
+            col = pn->coluna;
+            val = pn->valor;
+            pn = pn->prox;
+        } else {
+            col = pm->coluna;
+            val = pm->valor + pn->valor;
+            pm = pm->prox;
+            pn = pn->prox;
+            INSTR_CONTA(somas, 1);
+        }
 
-    novo->coluna = j;
-    novo->valor = delta;
-    novo->prox = atual;
+        if (val != 0.0f) {
+            No *novo = pool_alloc(pool);
+            if (!novo) return 1;
 
-    if (anterior) anterior->prox = novo;
-    else m->mat[linha] = novo;
+            novo->coluna = col;
+            novo->valor = val;
+            novo->prox = NULL;
 
+            *cauda = novo;
+            cauda = &novo->prox;
+        }
+    }
+    INSTR_SOMA(INSTR_ADD, passos + somas, 0, somas);
     return 0;
 }
 
-
 /**
  * @brief Calcula a soma de duas matrizes esparsas de mesmas dimensões.
  *
- * Cria uma nova matriz `res` tal que `res = m + n`. A soma é feita linha a linha,
- * percorrendo simultaneamente as listas encadeadas (ordenadas por coluna) de `m` e `n`,
+ * Cria uma nova matriz `res` tal que `res = m + n`. A soma é feita linha a linha
+ * por `matrix_add_row`, percorrendo simultaneamente as listas encadeadas (ordenadas
+ * por coluna) de `m` e `n` e anexando cada resultado ao final da linha de saída,
  * garantindo complexidade proporcional ao número de elementos não nulos.
  *
  * Elementos cujo resultado seja 0.0 não são armazenados na matriz resultante.
@@ -83,7 +128,6 @@ int matrix_addelem(Matrix *m, int i, int j, float delta) {
  * @return 0 em caso de sucesso.
  * @return 1 se `r` for NULL, se `m`/`n` forem NULL, se as dimensões forem incompatíveis,
  *         ou se falhar alguma alocação.
- * @return Código de erro propagado por `matrix_setelem`.
  *
  * @pre m != NULL
  * @pre n != NULL
@@ -97,43 +141,282 @@ int matrix_add(const Matrix *m, const Matrix *n, Matrix **r) {
     if (m->linhas != n->linhas || m->colunas != n->colunas) return 1;
 
     *r = NULL;
+    INSTR_INICIO(t0);
     Matrix *matrix_resultado = init_matrix(m->linhas, m->colunas);
     if (!matrix_resultado) return 1;
 
     for (int i = 0; i < m->linhas; i++) {
-        POINT pm = m->mat[i];
-        POINT pn = n->mat[i];
-
-        while (pm || pn) {
-            int col;
-            float val;
-
-            if (!pn || (pm && pm->coluna < pn->coluna)) {
-                col = pm->coluna;
-                val = pm->valor;
-                pm = pm->prox;
-            } else if (!pm || pn->coluna < pm->coluna) {
-                col = pn->coluna;
-                val = pn->valor;
-                pn = pn->prox;
+        int check = matrix_add_row(m, n, i, &matrix_resultado->pool, &matrix_resultado->mat[i]);
+        if (check) {
+            matrix_destroy(matrix_resultado);
+            return check;
+        }
+    }
+
+    INSTR_FIM(INSTR_ADD, t0, 0, 0, 0, matrix_resultado->pool.alocados, matrix_resultado->pool.liberados);
+    *r = matrix_resultado;
+    return 0;
+}
+
+/*
+ * Funde a linha i de `alfa * b` na linha i de `a`, no lugar: atualiza os nós
+ * de mesma coluna, encaixa nós novos (tirados de a->pool) onde b tem colunas
+ * que a não tem e devolve ao alocador os nós que resultam em 0.0. Em
+ * `*alterada` informa se a estrutura da linha mudou. Se faltar memória, a
+ * linha fica ordenada, com as colunas até o ponto da falha já somadas.
+ */
+static int axpy_linha(Matrix *a, float alfa, const Matrix *b, int i, int *alterada) {
+    POINT *ant = &a->mat[i];
+    POINT pb = b->mat[i];
+    INSTR_VAR(passos, 0);
+    INSTR_VAR(somas, 0);
+
+    *alterada = 0;
+    while (pb) {
+        INSTR_CONTA(passos, 1);
+        POINT pa = *ant;
+
+        if (pa && pa->coluna < pb->coluna) {
+            ant = &pa->prox;
+            continue;
+        }
+
+        if (pa && pa->coluna == pb->coluna) {
+            float v = pa->valor + alfa * pb->valor;
+            INSTR_CONTA(somas, 1);
+
+            if (v == 0.0f) {
+                *ant = pa->prox;
+                pool_free(&a->pool, pa);
+                *alterada = 1;
             } else {
-                col = pm->coluna;
-                val = pm->valor + pn->valor;
-                pm = pm->prox;
-                pn = pn->prox;
+                pa->valor = v;
+                ant = &pa->prox;
             }
+        } else {
+            float v = alfa * pb->valor;
+
+            if (v != 0.0f) {
+                No *novo = pool_alloc(&a->pool);
+                if (!novo) return 1;
 
-            if (val != 0.0f) {
-                int check = matrix_setelem(matrix_resultado, i + 1, col, val);
-                if (check) {
-                    matrix_destroy(matrix_resultado);
-                    return check;
-                }
+                novo->coluna = pb->coluna;
+                novo->valor = v;
+                novo->prox = pa;
+                *ant = novo;
+                ant = &novo->prox;
+                *alterada = 1;
             }
         }
+        pb = pb->prox;
     }
+    INSTR_SOMA(INSTR_ADD, passos + somas, 0, somas);
+    return 0;
+}
 
-    *r = matrix_resultado;
+/* A += alfa * A: cada valor vira v + alfa * v; os que resultam em 0.0 saem da linha. */
+static int axpy_proprio(Matrix *a, float alfa) {
+    int erro = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int removidos = 0;
+        POINT *ant = &a->mat[i];
+
+        while (*ant) {
+            POINT p = *ant;
+            float v = p->valor + alfa * p->valor;
+
+            if (v == 0.0f) {
+                *ant = p->prox;
+                pool_free(&a->pool, p);
+                removidos++;
+            } else {
+                p->valor = v;
+                ant = &p->prox;
+            }
+        }
+
+        if (removidos && a->indice && !erro && indice_reconstroi_linha(a, i)) erro = 1;
+    }
+
+    if (erro) matrix_index_disable(a);
+    return erro;
+}
+
+/**
+ * @brief Acumula `alfa * b` em `a`, no lugar (A += alfa * B).
+ *
+ * Cada linha de `b` é fundida na linha correspondente de `a` com um único
+ * percurso das duas listas: os nós de `a` em colunas presentes em `b` são
+ * reaproveitados (só o valor muda), apenas as colunas novas recebem nós,
+ * encaixados na posição certa, e os nós cujo valor resulta em 0.0 voltam ao
+ * alocador de `a`, que os reutiliza nas próximas inserções. Ao acumular
+ * repetidamente matrizes com o mesmo padrão de esparsidade, nenhum nó novo é
+ * alocado depois da primeira soma. Nenhuma matriz intermediária é criada.
+ *
+ * Com o índice por linha ligado, as linhas cuja estrutura mudou têm o índice
+ * refeito; se isso falhar, o índice é desligado (a matriz continua válida), a
+ * soma prossegue nas demais linhas e a função retorna 1 ao final.
+ * `b` pode ser a própria `a` (A += alfa * A).
+ *
+ * @param a Ponteiro para a matriz acumuladora (modificada in-place).
+ * @param alfa Escalar que multiplica `b` (0.0 não altera `a`).
+ * @param b Ponteiro constante para a matriz somada.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `a`/`b` forem NULL, se as dimensões forem incompatíveis, se
+ *         falhar a alocação de um nó ou se falhar a reconstrução do índice.
+ *
+ * @pre a->linhas == b->linhas e a->colunas == b->colunas
+ * @post Em sucesso, ou se só a reconstrução do índice falhar, `a` contém
+ *       a + alfa * b, com as linhas ordenadas por coluna. Em falha de alocação
+ *       de um nó, as linhas já processadas contêm a soma e as demais permanecem
+ *       inalteradas.
+ */
+int matrix_axpy(Matrix *a, float alfa, const Matrix *b) {
+    if (!a || !b || !a->mat || !b->mat) return 1;
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 1;
+    if (alfa == 0.0f) return 0;
+    if (a == b) return axpy_proprio(a, alfa);
+
+    INSTR_INICIO(t0);
+    INSTR_VAR(alocados0, a->pool.alocados);
+    INSTR_VAR(liberados0, a->pool.liberados);
+
+    int erro = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        int alterada;
+        int sem_memoria = axpy_linha(a, alfa, b, i, &alterada);
+
+        /* sem o índice a matriz continua válida: desliga-o e segue com as demais linhas */
+        if (alterada && a->indice && indice_reconstroi_linha(a, i)) {
+            matrix_index_disable(a);
+            erro = 1;
+        }
+        if (sem_memoria) {
+            erro = 1;
+            break;
+        }
+    }
+
+    INSTR_FIM(INSTR_ADD, t0, 0, 0, 0, a->pool.alocados - alocados0, a->pool.liberados - liberados0);
+    return erro;
+}
+
+/**
+ * @brief Soma `b` a `a`, no lugar (A += B).
+ *
+ * Equivale a `matrix_axpy(a, 1.0f, b)`: reaproveita os nós de `a` e aloca
+ * apenas as colunas novas. Os valores são os mesmos de `matrix_add(a, b, &r)`.
+ *
+ * @param a Ponteiro para a matriz acumuladora (modificada in-place).
+ * @param b Ponteiro constante para a matriz somada.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `a`/`b` forem NULL, se as dimensões forem incompatíveis ou se
+ *         falhar alguma alocação (ver `matrix_axpy`).
+ *
+ * @pre a->linhas == b->linhas e a->colunas == b->colunas
+ * @post Em sucesso, `a` contém a + b.
+ */
+int matrix_add_inplace(Matrix *a, const Matrix *b) {
+    return matrix_axpy(a, 1.0f, b);
+}
+
+/* Estimativa do tamanho da L2 usada para decidir pela transposta em blocos. */
+#ifndef TRANSPOSE_L2_BYTES
+#define TRANSPOSE_L2_BYTES (256 * 1024)
+#endif
+
+/*
+ * Anexa à transposta os elementos de colunas em [c0, c1] (base 1) de cada linha,
+ * começando em cursores[i] e deixando cursores[i] no primeiro nó depois de c1.
+ * caudas[j - c0] guarda o endereço do fim da linha j da transposta.
+ */
+static int transpose_faixa(const Matrix *m, NoPool *pool, POINT *cursores, POINT **caudas, int c0, int c1) {
+    for (int i = 0; i < m->linhas; i++) {
+        POINT atual = cursores[i];
+
+        while (atual && atual->coluna <= c1) {
+            No *novo = pool_alloc(pool);
+            if (!novo) return 1;
+
+            novo->coluna = i + 1;
+            novo->valor = atual->valor;
+            novo->prox = NULL;
+
+            *caudas[atual->coluna - c0] = novo;
+            caudas[atual->coluna - c0] = &novo->prox;
+            atual = atual->prox;
+        }
+        cursores[i] = atual;
+    }
+    return 0;
+}
+
+/**
+ * @brief Calcula a transposta de uma matriz esparsa em blocos de colunas.
+ *
+ * Igual a `matrix_transpose`, mas processa as colunas de `m` em faixas de `bloco`
+ * colunas. Em cada faixa, todas as linhas de `m` são visitadas a partir de um
+ * cursor salvo, de modo que cada lista é percorrida uma única vez no total e
+ * apenas `bloco` linhas da transposta recebem nós por vez (os ponteiros de fim
+ * dessas linhas cabem na cache). Custo O(nnz + linhas * (colunas / bloco)).
+ * Todos os nós da transposta são reservados de uma vez no alocador do resultado.
+ *
+ * @param m Ponteiro constante para a matriz de entrada.
+ * @param bloco Número de colunas por faixa (<= 0 usa um valor derivado de TRANSPOSE_L2_BYTES).
+ * @param r Endereço de ponteiro que receberá a matriz transposta.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `r` for NULL, se `m` for NULL, ou se falhar alguma alocação.
+ *
+ * @pre m != NULL
+ * @pre r != NULL
+ * @post Em sucesso, `*r` aponta para a transposta de `m`; em erro, `*r` permanece NULL.
+ */
+int matrix_transpose_blocked(const Matrix *m, int bloco, Matrix **r) {
+    if (!m || !m->mat || !r) return 1;
+
+    *r = NULL;
+    INSTR_INICIO(t0);
+    if (bloco <= 0) bloco = (int)(TRANSPOSE_L2_BYTES / (2 * sizeof(POINT*)));
+    if (bloco > m->colunas) bloco = m->colunas;
+
+    Matrix *res = init_matrix(m->colunas, m->linhas);
+    POINT *cursores = (POINT*)malloc((size_t)m->linhas * sizeof(POINT));
+    POINT **caudas = (POINT**)malloc((size_t)bloco * sizeof(POINT*));
+    if (!res || !cursores || !caudas) {
+        matrix_destroy(res);
+        free(cursores);
+        free(caudas);
+        return 1;
+    }
+
+    int nnz = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        cursores[i] = m->mat[i];
+        for (POINT p = m->mat[i]; p; p = p->prox) nnz++;
+    }
+
+    int erro = pool_reserve(&res->pool, nnz);
+    for (int c0 = 1; c0 <= m->colunas && !erro; c0 += bloco) {
+        int c1 = c0 + bloco - 1;
+        if (c1 > m->colunas) c1 = m->colunas;
+
+        for (int j = c0; j <= c1; j++) caudas[j - c0] = &res->mat[j - 1];
+        erro = transpose_faixa(m, &res->pool, cursores, caudas, c0, c1);
+    }
+
+    free(cursores);
+    free(caudas);
+
+    if (erro) {
+        matrix_destroy(res);
+        return erro;
+    }
+
+    INSTR_FIM(INSTR_TRANSPOSE, t0, 2LL * nnz, 0, 0, res->pool.alocados, res->pool.liberados);
+    *r = res;
     return 0;
 }
 
@@ -143,12 +426,18 @@ int matrix_add(const Matrix *m, const Matrix *n, Matrix **r) {
  * Cria uma nova matriz `res` com dimensões (m->colunas x m->linhas) tal que
  * `res(j, i) = m(i, j)` para todo elemento não nulo armazenado em `m`.
  *
+ * As linhas de `m` são percorridas em ordem e cada elemento é anexado ao fim da
+ * linha correspondente da transposta, guardado em um vetor de ponteiros de fim.
+ * Como i cresce, as linhas da transposta já saem ordenadas, em O(nnz + linhas + colunas).
+ * Uma passada de contagem permite reservar todos os nós do resultado de uma vez.
+ * Quando esse vetor não cabe na L2 (TRANSPOSE_L2_BYTES), delega para
+ * `matrix_transpose_blocked`.
+ *
  * @param m Ponteiro constante para a matriz de entrada.
  * @param r Endereço de ponteiro que receberá a matriz transposta.
  *
  * @return 0 em caso de sucesso.
  * @return 1 se `r` for NULL, se `m` for NULL, ou se falhar alguma alocação.
- * @return Código de erro propagado por `matrix_setelem`.
  *
  * @pre m != NULL
  * @pre r != NULL
@@ -157,33 +446,213 @@ int matrix_add(const Matrix *m, const Matrix *n, Matrix **r) {
 int matrix_transpose(const Matrix *m, Matrix **r) {
     if (!m || !m->mat || !r) return 1;
 
+    if ((size_t)m->colunas * sizeof(POINT*) > TRANSPOSE_L2_BYTES) {
+        return matrix_transpose_blocked(m, 0, r);
+    }
+
     *r = NULL;
+    INSTR_INICIO(t0);
     Matrix *res = init_matrix(m->colunas, m->linhas);
-    if (!res) return 1;
+    POINT **caudas = (POINT**)malloc((size_t)m->colunas * sizeof(POINT*));
+    if (!res || !caudas) {
+        matrix_destroy(res);
+        free(caudas);
+        return 1;
+    }
+
+    for (int j = 0; j < m->colunas; j++) caudas[j] = &res->mat[j];
+
+    int nnz = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) nnz++;
+    }
+    if (pool_reserve(&res->pool, nnz)) {
+        free(caudas);
+        matrix_destroy(res);
+        return 1;
+    }
 
     for (int i = 0; i < m->linhas; i++) {
-        POINT atual = m->mat[i];
-        while (atual) {
-            
-            int rr = matrix_setelem(res, atual->coluna, i + 1, atual->valor);
-            if (rr) {
+        for (POINT atual = m->mat[i]; atual; atual = atual->prox) {
+            No *novo = pool_alloc(&res->pool);
+            if (!novo) {
+                free(caudas);
                 matrix_destroy(res);
-                return rr;
+                return 1;
             }
-            atual = atual->prox;
+            novo->coluna = i + 1;
+            novo->valor = atual->valor;
+            novo->prox = NULL;
+
+            *caudas[atual->coluna - 1] = novo;
+            caudas[atual->coluna - 1] = &novo->prox;
         }
     }
 
+    free(caudas);
+    INSTR_FIM(INSTR_TRANSPOSE, t0, 2LL * nnz, 0, 0, res->pool.alocados, res->pool.liberados);
     *r = res;
     return 0;
 }
 
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
 /**
- * @brief Calcula o produto de duas matrizes esparsas.
+ * @brief Aloca os vetores de trabalho de um acumulador para `q` colunas.
+ *
+ * @param a Ponteiro para o acumulador.
+ * @param q Número de colunas do resultado.
  *
- * Cria uma nova matriz `res` tal que `res = m * n`. O algoritmo percorre cada linha de `m` e,
- * para cada elemento não nulo m(i, k), percorre a linha k de `n` (considerando o acesso por linhas),
- * acumulando contribuições em `res(i, j)` via somas incrementais.
+ * @return 0 em caso de sucesso.
+ * @return 1 se `a` for NULL ou se falhar alguma alocação.
+ *
+ * @post a->acc zerado e a->marca preenchido com -1.
+ */
+int acumulador_init(Acumulador *a, int q) {
+    if (!a) return 1;
+
+    a->q = q;
+    a->acc = (double*)calloc((size_t)q, sizeof(double));
+    a->marca = (int*)malloc((size_t)q * sizeof(int));
+    a->tocadas = (int*)malloc((size_t)q * sizeof(int));
+    if (!a->acc || !a->marca || !a->tocadas) {
+        acumulador_free(a);
+        return 1;
+    }
+    for (int j = 0; j < q; j++) a->marca[j] = -1;
+    return 0;
+}
+
+void acumulador_free(Acumulador *a) {
+    if (!a) return;
+
+    free(a->acc);
+    free(a->marca);
+    free(a->tocadas);
+    a->acc = NULL;
+    a->marca = NULL;
+    a->tocadas = NULL;
+}
+
+/**
+ * @brief Grava em `*saida` a linha acumulada e deixa o acumulador limpo.
+ *
+ * As colunas tocadas (marcadas com `i`) são ordenadas e os valores acumulados
+ * são arredondados para float e anexados, em ordem, ao final da lista;
+ * valores que resultarem em 0.0 não são armazenados.
+ *
+ * @param a Acumulador com `ntoc` colunas em a->tocadas, marcadas com `i`.
+ * @param i Marca usada na linha (o índice da linha de saída).
+ * @param ntoc Número de colunas tocadas.
+ * @param pool Alocador dos nós da saída; NULL apenas limpa o acumulador.
+ * @param saida Endereço da cabeça da lista de saída (deve estar vazia).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se falhar a alocação de um nó (o acumulador é limpo mesmo assim).
+ */
+int acumulador_emite(Acumulador *a, int i, int ntoc, NoPool *pool, POINT *saida) {
+    int q = a->q;
+    int erro = 0;
+
+    /* Linhas muito cheias: varrer o vetor de marcação sai mais barato que ordenar. */
+    if (ntoc > q / 8) {
+        ntoc = 0;
+        for (int j = 0; j < q; j++) {
+            if (a->marca[j] == i) a->tocadas[ntoc++] = j;
+        }
+    } else {
+        qsort(a->tocadas, (size_t)ntoc, sizeof(int), cmp_int);
+    }
+
+    POINT *cauda = saida;
+    for (int t = 0; t < ntoc; t++) {
+        int j = a->tocadas[t];
+        float val = (float)a->acc[j];
+        a->acc[j] = 0.0;
+
+        if (val == 0.0f || erro || !pool) continue;
+
+        No *novo = pool_alloc(pool);
+        if (!novo) {
+            erro = 1;
+            continue;
+        }
+        novo->coluna = j + 1;
+        novo->valor = val;
+        novo->prox = NULL;
+
+        *cauda = novo;
+        cauda = &novo->prox;
+    }
+    return erro;
+}
+
+/**
+ * @brief Monta a linha i de `m * n` em `*saida` (algoritmo de Gustavson).
+ *
+ * As contribuições m(i, k) * n(k, j) são acumuladas em double no vetor denso do
+ * acumulador e arredondadas para float uma única vez, ao montar a linha;
+ * o vetor de marcação registra quais colunas foram tocadas. Ao final, as colunas
+ * tocadas são ordenadas e a linha é montada uma única vez, com os nós reservados
+ * de uma vez no alocador e anexados ao final da lista. O custo é proporcional ao
+ * número de produtos parciais.
+ *
+ * @param m Ponteiro constante para a matriz à esquerda.
+ * @param n Ponteiro constante para a matriz à direita.
+ * @param i Índice da linha (base 0).
+ * @param a Acumulador com q == n->colunas; é deixado limpo ao retornar.
+ * @param pool Alocador de onde saem os nós da linha de saída.
+ * @param saida Endereço da cabeça da lista de saída (deve estar vazia).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se falhar a alocação de um nó.
+ * @return 2 se `m` contiver uma coluna fora dos limites de `n`.
+ */
+int matrix_multiply_row(const Matrix *m, const Matrix *n, int i, Acumulador *a, NoPool *pool, POINT *saida) {
+    int ntoc = 0;
+    int erro = 0;
+    INSTR_VAR(passos, 0);
+    INSTR_VAR(produtos, 0);
+
+    for (POINT pm = m->mat[i]; pm; pm = pm->prox) {
+        int k = pm->coluna;
+        INSTR_CONTA(passos, 1);
+        if (k < 1 || k > n->linhas) {
+            erro = 2;
+            break;
+        }
+
+        for (POINT pn = n->mat[k - 1]; pn; pn = pn->prox) {
+            int j = pn->coluna - 1;
+            if (a->marca[j] != i) {
+                a->marca[j] = i;
+                a->tocadas[ntoc++] = j;
+            }
+            a->acc[j] += (double)pm->valor * pn->valor;
+            INSTR_CONTA(produtos, 1);
+        }
+    }
+    if (!erro && pool_reserve(pool, ntoc)) erro = 1;
+
+    int e = acumulador_emite(a, i, ntoc, erro ? NULL : pool, saida);
+    if (erro || e) return erro ? erro : e;
+
+    /* só as linhas montadas entram nos contadores */
+    INSTR_SOMA(INSTR_MULTIPLY, passos + produtos, produtos, 2 * produtos);
+    return 0;
+}
+
+/**
+ * @brief Calcula o produto de duas matrizes esparsas (algoritmo de Gustavson).
+ *
+ * Cria uma nova matriz `res` tal que `res = m * n`, montando cada linha com
+ * `matrix_multiply_row`: as contribuições são acumuladas em um vetor denso e a
+ * linha do resultado é gravada uma única vez, já ordenada, sem repercorrer a
+ * lista do resultado a cada produto parcial.
  *
  * Elementos cujo valor acumulado final resulte em 0.0 são removidos (não armazenados).
  *
@@ -194,7 +663,7 @@ int matrix_transpose(const Matrix *m, Matrix **r) {
  * @return 0 em caso de sucesso.
  * @return 1 se `r` for NULL, se `m`/`n` forem NULL, se as dimensões forem incompatíveis
  *         (m->colunas != n->linhas), ou se falhar alguma alocação.
- * @return Código de erro propagado por `matrix_addelem`.
+ * @return 2 se `m` contiver uma coluna fora dos limites de `n`.
  *
  * @pre m != NULL
  * @pre n != NULL
@@ -208,39 +677,29 @@ int matrix_multiply(const Matrix *m, const Matrix *n, Matrix **r) {
     if (m->colunas != n->linhas) return 1;
 
     *r = NULL;
+    INSTR_INICIO(t0);
     Matrix *matrix_resultado = init_matrix(m->linhas, n->colunas);
     if (!matrix_resultado) return 1;
 
-    for (int i = 0; i < m->linhas; i++) {
-        POINT pm = m->mat[i];
+    Acumulador a;
+    if (acumulador_init(&a, n->colunas)) {
+        matrix_destroy(matrix_resultado);
+        return 1;
+    }
 
-        while (pm) {
-            int k = pm->coluna;
-            if (k < 1 || k > n->linhas) {
-                matrix_destroy(matrix_resultado);
-                return 2;
-            }
+    int erro = 0;
+    for (int i = 0; i < m->linhas && !erro; i++) {
+        erro = matrix_multiply_row(m, n, i, &a, &matrix_resultado->pool, &matrix_resultado->mat[i]);
+    }
 
-            POINT pn = n->mat[k - 1];
-
-            while (pn) {
-                float prod = pm->valor * pn->valor;
-                if (prod != 0.0) {
-                    int check = matrix_addelem(matrix_resultado,
-                                               i + 1,
-                                               pn->coluna,
-                                               prod);
-                    if (check) {
-                        matrix_destroy(matrix_resultado);
-                        return check;
-                    }
-                }
-                pn = pn->prox;
-            }
-            pm = pm->prox;
-        }
+    acumulador_free(&a);
+
+    if (erro) {
+        matrix_destroy(matrix_resultado);
+        return erro;
     }
 
+    INSTR_FIM(INSTR_MULTIPLY, t0, 0, 0, 0, matrix_resultado->pool.alocados, matrix_resultado->pool.liberados);
     *r = matrix_resultado;
     return 0;
 }
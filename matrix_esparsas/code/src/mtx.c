@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include "mtx.h"
+#include "coo.h"
+#include "csr.h"
+
+/* Tamanho dos blocos lidos/escritos de uma vez. */
+#define MTX_BUFFER (1 << 20)
+
+/* Leitor com buffer próprio: o arquivo é lido em blocos grandes com fread. */
+typedef struct Leitor {
+    FILE *f;
+    char *buf;
+    size_t pos;
+    size_t tam;
+} Leitor;
+
+static int espia(Leitor *l) {
+    if (l->pos == l->tam) {
+        l->tam = fread(l->buf, 1, MTX_BUFFER, l->f);
+        l->pos = 0;
+        if (l->tam == 0) return EOF;
+    }
+    return (unsigned char)l->buf[l->pos];
+}
+
+static void pula_linha(Leitor *l) {
+    int c;
+    while ((c = espia(l)) != EOF) {
+        l->pos++;
+        if (c == '\n') break;
+    }
+}
+
+/* Pula espaços, quebras de linha e linhas de comentário ('%'). */
+static void pula_espacos(Leitor *l) {
+    int c;
+    while ((c = espia(l)) != EOF) {
+        if (c == '%') pula_linha(l);
+        else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') l->pos++;
+        else break;
+    }
+}
+
+/*
+ * Lê [sinal] dígitos. Retorna 1 se não houver dígitos e 2 se o valor não
+ * couber em long long; nesse caso, os dígitos são consumidos e `*v` recebe
+ * o valor saturado (±LLONG_MAX).
+ */
+static int le_inteiro(Leitor *l, long long *v) {
+    pula_espacos(l);
+
+    int c = espia(l);
+    int neg = 0;
+    if (c == '-' || c == '+') {
+        neg = (c == '-');
+        l->pos++;
+        c = espia(l);
+    }
+    if (c < '0' || c > '9') return 1;
+
+    long long x = 0;
+    int estouro = 0;
+    while (c >= '0' && c <= '9') {
+        int d = c - '0';
+        if (estouro || x > (LLONG_MAX - d) / 10) {
+            estouro = 1;
+            x = LLONG_MAX;
+        } else {
+            x = x * 10 + d;
+        }
+        l->pos++;
+        c = espia(l);
+    }
+    *v = neg ? -x : x;
+    return estouro ? 2 : 0;
+}
+
+/*
+ * Converte [sinal] dígitos [. dígitos] [e|E [sinal] dígitos] sem usar scanf/strtod.
+ * Até 19 dígitos significativos entram na mantissa; o restante só ajusta o expoente.
+ */
+static int le_real(Leitor *l, double *v) {
+    static const double pot10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    pula_espacos(l);
+
+    int c = espia(l);
+    int neg = 0;
+    if (c == '-' || c == '+') {
+        neg = (c == '-');
+        l->pos++;
+        c = espia(l);
+    }
+
+    unsigned long long mant = 0;
+    int digitos = 0, expo = 0, algum = 0;
+
+    while (c >= '0' && c <= '9') {
+        if (digitos < 19) {
+            mant = mant * 10 + (unsigned)(c - '0');
+            if (mant) digitos++;
+        } else {
+            expo++;
+        }
+        algum = 1;
+        l->pos++;
+        c = espia(l);
+    }
+    if (c == '.') {
+        l->pos++;
+        c = espia(l);
+        while (c >= '0' && c <= '9') {
+            if (digitos < 19) {
+                mant = mant * 10 + (unsigned)(c - '0');
+                if (mant) digitos++;
+                expo--;
+            }
+            algum = 1;
+            l->pos++;
+            c = espia(l);
+        }
+    }
+    if (!algum) return 1;
+
+    if (c == 'e' || c == 'E') {
+        long long e;
+        l->pos++;
+        if (le_inteiro(l, &e) == 1) return 1;
+        /* expoente saturado: o resultado já vira inf ou 0 */
+        if (e > 400) e = 400;
+        if (e < -400) e = -400;
+        expo += (int)e;
+    }
+
+    double x = (double)mant;
+    while (expo > 22) {
+        x *= 1e22;
+        expo -= 22;
+    }
+    while (expo < -22) {
+        x /= 1e22;
+        expo += 22;
+    }
+    x = expo >= 0 ? x * pot10[expo] : x / pot10[-expo];
+
+    *v = neg ? -x : x;
+    return 0;
+}
+
+static int le_palavra(Leitor *l, char *dst, size_t max) {
+    int c;
+    while ((c = espia(l)) == ' ' || c == '\t') l->pos++;
+
+    size_t n = 0;
+    while ((c = espia(l)) != EOF && !isspace(c)) {
+        if (n + 1 < max) dst[n++] = (char)tolower(c);
+        l->pos++;
+    }
+    dst[n] = '\0';
+    return n == 0;
+}
+
+/*
+ * Lê o arquivo inteiro como triplas (base 1). Para matrizes simétricas, o
+ * elemento (j, i) é gerado a partir de cada (i, j) fora da diagonal.
+ */
+static int le_triplas(const char *caminho, int *linhas, int *colunas,
+                      int **is, int **js, float **vals, int *nnz) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return 1;
+
+    Leitor l;
+    l.f = f;
+    l.pos = 0;
+    l.tam = 0;
+    l.buf = (char*)malloc(MTX_BUFFER);
+    if (!l.buf) {
+        fclose(f);
+        return 1;
+    }
+
+    char banner[32] = "", objeto[32] = "", formato[32] = "", campo[32] = "", simetria[32] = "";
+    int erro = 0;
+
+    if (le_palavra(&l, banner, sizeof banner) || strcmp(banner, "%%matrixmarket") != 0 ||
+        le_palavra(&l, objeto, sizeof objeto) || strcmp(objeto, "matrix") != 0 ||
+        le_palavra(&l, formato, sizeof formato) || strcmp(formato, "coordinate") != 0 ||
+        le_palavra(&l, campo, sizeof campo) ||
+        le_palavra(&l, simetria, sizeof simetria)) {
+        erro = 2;
+    }
+
+    int padrao = !strcmp(campo, "pattern");
+    if (!erro && !padrao && strcmp(campo, "real") && strcmp(campo, "integer") && strcmp(campo, "double")) {
+        erro = 2;
+    }
+
+    int sim = 0;
+    if (!erro) {
+        if (!strcmp(simetria, "symmetric")) sim = 1;
+        else if (!strcmp(simetria, "skew-symmetric")) sim = -1;
+        else if (strcmp(simetria, "general")) erro = 2;
+    }
+
+    long long m = 0, n = 0, nz = 0;
+    if (!erro) {
+        pula_linha(&l);
+        if (le_inteiro(&l, &m) || le_inteiro(&l, &n) || le_inteiro(&l, &nz)) erro = 2;
+        else if (m <= 0 || n <= 0 || nz < 0 || m > 0x7fffffff || n > 0x7fffffff) erro = 2;
+        else if (nz > (sim ? 0x3fffffff : 0x7fffffff)) erro = 1;
+    }
+
+    long long cap = sim ? 2 * nz : nz;
+    int *vi = NULL, *vj = NULL;
+    float *vv = NULL;
+    if (!erro) {
+        vi = (int*)malloc((cap ? (size_t)cap : 1) * sizeof(int));
+        vj = (int*)malloc((cap ? (size_t)cap : 1) * sizeof(int));
+        vv = (float*)malloc((cap ? (size_t)cap : 1) * sizeof(float));
+        if (!vi || !vj || !vv) erro = 1;
+    }
+
+    int k = 0;
+    for (long long t = 0; t < nz && !erro; t++) {
+        long long i, j;
+        double v = 1.0;
+
+        if (le_inteiro(&l, &i) || le_inteiro(&l, &j)) erro = 2;
+        else if (!padrao && le_real(&l, &v)) erro = 2;
+        else if (i < 1 || i > m || j < 1 || j > n) erro = 2;
+        if (erro) break;
+
+        vi[k] = (int)i;
+        vj[k] = (int)j;
+        vv[k] = (float)v;
+        k++;
+
+        if (sim && i != j) {
+            vi[k] = (int)j;
+            vj[k] = (int)i;
+            vv[k] = sim < 0 ? -(float)v : (float)v;
+            k++;
+        }
+    }
+
+    free(l.buf);
+    fclose(f);
+
+    if (erro) {
+        free(vi);
+        free(vj);
+        free(vv);
+        return erro;
+    }
+
+    *linhas = (int)m;
+    *colunas = (int)n;
+    *is = vi;
+    *js = vj;
+    *vals = vv;
+    *nnz = k;
+    return 0;
+}
+
+/**
+ * @brief Lê uma matriz no formato Matrix Market (coordinate) para CSR.
+ *
+ * Aceita os campos `real`, `integer` e `pattern` (elementos sem valor viram 1.0)
+ * e as simetrias `general`, `symmetric` e `skew-symmetric` (a parte omitida é
+ * reconstruída). O arquivo é lido em blocos de MTX_BUFFER bytes e os números são
+ * convertidos por um analisador próprio, sem scanf. Elementos repetidos são somados.
+ *
+ * @param caminho Caminho do arquivo .mtx.
+ * @param r Endereço de ponteiro que receberá a matriz CSR.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se o arquivo não puder ser aberto ou se falhar alguma alocação.
+ * @return 2 se o arquivo não estiver no formato esperado ou tiver índices fora dos limites.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz CSR; em erro, `*r` permanece NULL.
+ */
+int csr_read_mtx(const char *caminho, MatrixCSR **r) {
+    if (!caminho || !r) return 1;
+    *r = NULL;
+
+    int linhas, colunas, nnz;
+    int *is, *js;
+    float *vals;
+    int erro = le_triplas(caminho, &linhas, &colunas, &is, &js, &vals, &nnz);
+    if (erro) return erro;
+
+    erro = csr_from_coo(linhas, colunas, is, js, vals, nnz, r);
+    free(is);
+    free(js);
+    free(vals);
+    return erro;
+}
+
+/**
+ * @brief Lê uma matriz no formato Matrix Market (coordinate).
+ *
+ * Mesmo comportamento de `csr_read_mtx`, produzindo a matriz em listas encadeadas.
+ * Substitui a leitura interativa de `matrix_create` para arquivos grandes.
+ *
+ * @param caminho Caminho do arquivo .mtx.
+ * @param r Endereço de ponteiro que receberá a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se o arquivo não puder ser aberto ou se falhar alguma alocação.
+ * @return 2 se o arquivo não estiver no formato esperado ou tiver índices fora dos limites.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_read_mtx(const char *caminho, Matrix **r) {
+    if (!caminho || !r) return 1;
+    *r = NULL;
+
+    int linhas, colunas, nnz;
+    int *is, *js;
+    float *vals;
+    int erro = le_triplas(caminho, &linhas, &colunas, &is, &js, &vals, &nnz);
+    if (erro) return erro;
+
+    erro = matrix_from_coo(linhas, colunas, is, js, vals, nnz, r);
+    free(is);
+    free(js);
+    free(vals);
+    return erro;
+}
+
+static FILE* abre_escrita(const char *caminho, char **buf) {
+    FILE *f = fopen(caminho, "wb");
+    if (!f) return NULL;
+
+    *buf = (char*)malloc(MTX_BUFFER);
+    if (*buf) setvbuf(f, *buf, _IOFBF, MTX_BUFFER);
+    return f;
+}
+
+static int fecha_escrita(FILE *f, char *buf, int erro) {
+    if (ferror(f)) erro = 1;
+    if (fclose(f) != 0) erro = 1;
+    free(buf);
+    return erro;
+}
+
+/**
+ * @brief Grava uma matriz CSR no formato Matrix Market (coordinate real general).
+ *
+ * @param caminho Caminho do arquivo de saída (sobrescrito se existir).
+ * @param c Ponteiro constante para a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se ocorrer erro de escrita.
+ */
+int csr_write_mtx(const char *caminho, const MatrixCSR *c) {
+    if (!caminho || !c) return 1;
+
+    char *buf = NULL;
+    FILE *f = abre_escrita(caminho, &buf);
+    if (!f) return 1;
+
+    fprintf(f, "%%%%MatrixMarket matrix coordinate real general\n");
+    fprintf(f, "%d %d %d\n", c->linhas, c->colunas, c->nnz);
+    for (int i = 0; i < c->linhas; i++) {
+        for (int k = c->row_ptr[i]; k < c->row_ptr[i + 1]; k++) {
+            fprintf(f, "%d %d %.9g\n", i + 1, c->col_idx[k] + 1, (double)c->values[k]);
+        }
+    }
+
+    return fecha_escrita(f, buf, 0);
+}
+
+/**
+ * @brief Grava uma matriz no formato Matrix Market (coordinate real general).
+ *
+ * @param caminho Caminho do arquivo de saída (sobrescrito se existir).
+ * @param m Ponteiro constante para a matriz.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se ocorrer erro de escrita.
+ */
+int matrix_write_mtx(const char *caminho, const Matrix *m) {
+    if (!caminho || !m || !m->mat) return 1;
+
+    long long nnz = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) nnz++;
+    }
+
+    char *buf = NULL;
+    FILE *f = abre_escrita(caminho, &buf);
+    if (!f) return 1;
+
+    fprintf(f, "%%%%MatrixMarket matrix coordinate real general\n");
+    fprintf(f, "%d %d %lld\n", m->linhas, m->colunas, nnz);
+    for (int i = 0; i < m->linhas; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            fprintf(f, "%d %d %.9g\n", i + 1, p->coluna, (double)p->valor);
+        }
+    }
+
+    return fecha_escrita(f, buf, 0);
+}
@@ -0,0 +1,761 @@
+/* _GNU_SOURCE para pthread_attr_setaffinity_np/sched_getaffinity (afinidade no Linux). */
+#define _GNU_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "parallel.h"
+#include "csr.h"
+#include "timer.h"
+#include "create.h"
+#include "math.h"
+#include "pool.h"
+#include "batch.h"
+#include "indice.h"
+#include "instrument.h"
+#include "spmm.h"
+
+typedef struct TarefaLinhas {
+    const Matrix *m;
+    const Matrix *n;
+    Matrix *res;
+    const void *dados;
+    NoPool pool;
+    int ini;
+    int fim;
+    int erro;
+} TarefaLinhas;
+
+/**
+ * @brief Resolve o número de threads a usar.
+ *
+ * @param nthreads Valor pedido pelo chamador; <= 0 usa o número de processadores online.
+ *
+ * @return Número de threads (>= 1).
+ */
+int parallel_num_threads(int nthreads) {
+    if (nthreads > 0) return nthreads;
+
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+/**
+ * @brief Divide as linhas em faixas contíguas de custo aproximadamente igual.
+ *
+ * `prefixo` é a soma de prefixos do custo por linha (prefixo[0] == 0 e
+ * prefixo[linhas] == custo total). A parte t recebe as linhas
+ * [limites[t], limites[t + 1]). O corte é feito por busca binária no prefixo,
+ * de modo que linhas muito pesadas não concentrem o trabalho em uma thread.
+ *
+ * @param prefixo Vetor com linhas + 1 posições.
+ * @param linhas Número de linhas.
+ * @param partes Número de faixas.
+ * @param limites Vetor com partes + 1 posições, preenchido pela função.
+ */
+void parallel_partition(const long long *prefixo, int linhas, int partes, int *limites) {
+    long long total = prefixo[linhas];
+
+    limites[0] = 0;
+    for (int t = 1; t < partes; t++) {
+        long long alvo = total * t / partes;
+        int ini = limites[t - 1], fim = linhas;
+
+        while (ini < fim) {
+            int meio = ini + (fim - ini) / 2;
+            if (prefixo[meio] < alvo) ini = meio + 1;
+            else fim = meio;
+        }
+        limites[t] = ini;
+    }
+    limites[partes] = linhas;
+}
+
+static void* tarefa_add(void *arg) {
+    TarefaLinhas *t = (TarefaLinhas*)arg;
+
+    for (int i = t->ini; i < t->fim && !t->erro; i++) {
+        t->erro = matrix_add_row(t->m, t->n, i, &t->pool, &t->res->mat[i]);
+    }
+    return NULL;
+}
+
+static void* tarefa_multiply(void *arg) {
+    TarefaLinhas *t = (TarefaLinhas*)arg;
+
+    Acumulador a;
+    if (acumulador_init(&a, t->n->colunas)) {
+        t->erro = 1;
+        return NULL;
+    }
+
+    for (int i = t->ini; i < t->fim && !t->erro; i++) {
+        t->erro = matrix_multiply_row(t->m, t->n, i, &a, &t->pool, &t->res->mat[i]);
+    }
+
+    acumulador_free(&a);
+    return NULL;
+}
+
+static void* tarefa_setelem_batch(void *arg) {
+    TarefaLinhas *t = (TarefaLinhas*)arg;
+    const LoteOrdenado *l = (const LoteOrdenado*)t->dados;
+
+    for (int i = t->ini; i < t->fim && !t->erro; i++) {
+        t->erro = matrix_setelem_batch_row(t->res, l, i, &t->pool);
+    }
+    return NULL;
+}
+
+/*
+ * Dispara uma thread por faixa de linhas e espera todas terminarem.
+ * Cada thread grava apenas as linhas da sua faixa em `res`, então o
+ * resultado não depende do número de threads nem da ordem de execução.
+ * Os nós de cada faixa vêm do alocador da própria tarefa e, ao final,
+ * são transferidos para o alocador de `res`. `dados` é repassado às tarefas
+ * (o lote ordenado, em `matrix_setelem_batch_parallel`).
+ */
+static int executa_faixas(const Matrix *m, const Matrix *n, Matrix *res, const void *dados,
+                          const long long *prefixo, int nthreads,
+                          void *(*rotina)(void*)) {
+    int linhas = res->linhas;
+    if (nthreads > linhas) nthreads = linhas;
+
+    int *limites = (int*)malloc(((size_t)nthreads + 1) * sizeof(int));
+    TarefaLinhas *tarefas = (TarefaLinhas*)malloc((size_t)nthreads * sizeof(TarefaLinhas));
+    pthread_t *threads = (pthread_t*)malloc((size_t)nthreads * sizeof(pthread_t));
+    if (!limites || !tarefas || !threads) {
+        free(limites);
+        free(tarefas);
+        free(threads);
+        return 1;
+    }
+
+    parallel_partition(prefixo, linhas, nthreads, limites);
+
+    int criadas = 0;
+    for (int t = 0; t < nthreads; t++) {
+        tarefas[t].m = m;
+        tarefas[t].n = n;
+        tarefas[t].res = res;
+        tarefas[t].dados = dados;
+        tarefas[t].ini = limites[t];
+        tarefas[t].fim = limites[t + 1];
+        tarefas[t].erro = 0;
+        pool_init(&tarefas[t].pool);
+
+        /* A última faixa roda na própria thread chamadora. */
+        if (t == nthreads - 1) break;
+        if (pthread_create(&threads[t], NULL, rotina, &tarefas[t]) != 0) {
+            tarefas[t].erro = 1;
+            break;
+        }
+        criadas++;
+    }
+
+    if (criadas == nthreads - 1) rotina(&tarefas[nthreads - 1]);
+
+    int erro = 0;
+    for (int t = 0; t < criadas; t++) pthread_join(threads[t], NULL);
+    for (int t = 0; t <= criadas && t < nthreads; t++) {
+        if (tarefas[t].erro && !erro) erro = tarefas[t].erro;
+        pool_merge(&res->pool, &tarefas[t].pool);
+    }
+
+    free(limites);
+    free(tarefas);
+    free(threads);
+    return erro;
+}
+
+static int row_length(POINT p) {
+    int len = 0;
+    for (; p; p = p->prox) len++;
+    return len;
+}
+
+/**
+ * @brief Versão paralela de `matrix_add`.
+ *
+ * As linhas do resultado são divididas entre as threads pelo número de nós
+ * das linhas de `m` e `n` (e não pela quantidade de linhas). O resultado é
+ * idêntico ao de `matrix_add`.
+ *
+ * @param m Ponteiro constante para a primeira matriz.
+ * @param n Ponteiro constante para a segunda matriz.
+ * @param r Endereço de ponteiro que receberá a matriz resultante.
+ * @param nthreads Número de threads (<= 0 usa todos os processadores).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se as dimensões forem incompatíveis
+ *         ou se falhar alguma alocação ou criação de thread.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_add_parallel(const Matrix *m, const Matrix *n, Matrix **r, int nthreads) {
+    if (!m || !n || !r) return 1;
+    if (!m->mat || !n->mat) return 1;
+    if (m->linhas != n->linhas || m->colunas != n->colunas) return 1;
+
+    nthreads = parallel_num_threads(nthreads);
+    if (nthreads == 1) return matrix_add(m, n, r);
+
+    *r = NULL;
+    INSTR_INICIO(t0);
+    Matrix *res = init_matrix(m->linhas, m->colunas);
+    long long *prefixo = (long long*)malloc(((size_t)m->linhas + 1) * sizeof(long long));
+    if (!res || !prefixo) {
+        matrix_destroy(res);
+        free(prefixo);
+        return 1;
+    }
+
+    prefixo[0] = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        prefixo[i + 1] = prefixo[i] + 1 + row_length(m->mat[i]) + row_length(n->mat[i]);
+    }
+
+    int erro = executa_faixas(m, n, res, NULL, prefixo, nthreads, tarefa_add);
+    free(prefixo);
+
+    if (erro) {
+        matrix_destroy(res);
+        return erro;
+    }
+
+    INSTR_FIM(INSTR_ADD, t0, 0, 0, 0, res->pool.alocados, res->pool.liberados);
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Versão paralela de `matrix_multiply`.
+ *
+ * O custo de cada linha i é o número de produtos parciais (soma dos tamanhos
+ * das linhas de `n` referenciadas por m(i, :)); as linhas são divididas entre
+ * as threads por esse custo. Cada thread usa seu próprio acumulador. O
+ * resultado é idêntico ao de `matrix_multiply`.
+ *
+ * @param m Ponteiro constante para a matriz à esquerda (m x p).
+ * @param n Ponteiro constante para a matriz à direita (p x q).
+ * @param r Endereço de ponteiro que receberá a matriz produto.
+ * @param nthreads Número de threads (<= 0 usa todos os processadores).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se m->colunas != n->linhas
+ *         ou se falhar alguma alocação ou criação de thread.
+ * @return 2 se `m` contiver uma coluna fora dos limites de `n`.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_multiply_parallel(const Matrix *m, const Matrix *n, Matrix **r, int nthreads) {
+    if (!m || !n || !r) return 1;
+    if (!m->mat || !n->mat) return 1;
+    if (m->colunas != n->linhas) return 1;
+
+    nthreads = parallel_num_threads(nthreads);
+    if (nthreads == 1) return matrix_multiply(m, n, r);
+
+    *r = NULL;
+    INSTR_INICIO(t0);
+    Matrix *res = init_matrix(m->linhas, n->colunas);
+    long long *prefixo = (long long*)malloc(((size_t)m->linhas + 1) * sizeof(long long));
+    int *tam_n = (int*)malloc((size_t)n->linhas * sizeof(int));
+    if (!res || !prefixo || !tam_n) {
+        matrix_destroy(res);
+        free(prefixo);
+        free(tam_n);
+        return 1;
+    }
+
+    for (int k = 0; k < n->linhas; k++) tam_n[k] = row_length(n->mat[k]);
+
+    prefixo[0] = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        long long custo = 1;
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            if (p->coluna >= 1 && p->coluna <= n->linhas) custo += tam_n[p->coluna - 1];
+        }
+        prefixo[i + 1] = prefixo[i] + custo;
+    }
+    free(tam_n);
+
+    int erro = executa_faixas(m, n, res, NULL, prefixo, nthreads, tarefa_multiply);
+    free(prefixo);
+
+    if (erro) {
+        matrix_destroy(res);
+        return erro;
+    }
+
+    INSTR_FIM(INSTR_MULTIPLY, t0, 0, 0, 0, res->pool.alocados, res->pool.liberados);
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Versão paralela de `matrix_setelem_batch`.
+ *
+ * O lote é ordenado uma vez e as linhas são divididas entre as threads pelo
+ * custo estimado da passada de cada linha: as entradas do lote na linha e,
+ * com o índice por linha ligado, os nós da linha tocada (o tamanho vem do
+ * índice, sem percorrer a lista). Cada thread altera apenas as suas linhas; os novos nós vêm
+ * do alocador da tarefa e os removidos voltam para ele, e tudo é transferido
+ * para `m->pool` ao final. O resultado é idêntico ao de `matrix_setelem_batch`.
+ *
+ * @param m Ponteiro para a matriz.
+ * @param is Índices de linha (base 1).
+ * @param js Índices de coluna (base 1).
+ * @param vals Valores.
+ * @param k Número de posições.
+ * @param nthreads Número de threads (<= 0 usa todos os processadores).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se falhar alguma alocação ou criação
+ *         de thread; nesse caso, parte do lote pode já ter sido aplicada e o
+ *         índice por linha é desligado.
+ * @return 2 se algum índice estiver fora dos limites (a matriz não é alterada).
+ */
+int matrix_setelem_batch_parallel(Matrix *m, const int *is, const int *js, const float *vals, int k, int nthreads) {
+    if (k > 0 && !vals) return 1;
+
+    nthreads = parallel_num_threads(nthreads);
+    if (nthreads == 1) return matrix_setelem_batch(m, is, js, vals, k);
+
+    LoteOrdenado l;
+    int erro = lote_ordena(m, is, js, vals, k, &l);
+    if (erro) return erro;
+
+    long long *prefixo = (long long*)malloc(((size_t)m->linhas + 1) * sizeof(long long));
+    if (!prefixo) {
+        lote_free(&l);
+        return 1;
+    }
+
+    /* percorrer as linhas só para medi-las custaria tanto quanto a própria passada */
+    prefixo[0] = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        int entradas = l.inicio[i + 1] - l.inicio[i];
+        int nos = (entradas && m->indice) ? m->indice[i].n : 0;
+        prefixo[i + 1] = prefixo[i] + 1 + entradas + nos;
+    }
+
+    erro = executa_faixas(NULL, NULL, m, &l, prefixo, nthreads, tarefa_setelem_batch);
+    if (erro) matrix_index_disable(m);
+
+    free(prefixo);
+    lote_free(&l);
+    return erro;
+}
+
+/* ===== SpMV paralelo (CSR) ===== */
+
+typedef struct TarefaSpmv {
+    PlanoSpmv *plano;
+    const MatrixCSR *origem;
+    const float *x;
+    float *y;
+    int id;
+} TarefaSpmv;
+
+/*
+ * Ponto do caminho de intercalação (merge path) na diagonal d: o caminho
+ * percorre os fins de linha (row_ptr[i + 1]) e os elementos (0 .. nnz - 1);
+ * na diagonal d foram consumidos `*li` fins de linha e `*pk` elementos, com
+ * *li + *pk == d.
+ */
+static void merge_path(const int *row_ptr, int linhas, int nnz, long long d, int *li, int *pk) {
+    int lo = d > nnz ? (int)(d - nnz) : 0;
+    int hi = d < linhas ? (int)d : linhas;
+
+    while (lo < hi) {
+        int meio = lo + (hi - lo) / 2;
+        if (row_ptr[meio + 1] <= d - meio - 1) lo = meio + 1;
+        else hi = meio;
+    }
+    *li = lo;
+    *pk = (int)(d - lo);
+}
+
+/* Cópia da faixa da thread: as páginas ficam no nó NUMA de quem escreve primeiro. */
+static void* tarefa_spmv_copia(void *arg) {
+    TarefaSpmv *t = (TarefaSpmv*)arg;
+    const PlanoSpmv *p = t->plano;
+    const MatrixCSR *o = t->origem;
+    int k0 = p->pos[t->id], k1 = p->pos[t->id + 1];
+
+    memcpy(p->a->row_ptr + p->linha[t->id], o->row_ptr + p->linha[t->id],
+           (size_t)(p->linha[t->id + 1] - p->linha[t->id]) * sizeof(int));
+    memcpy(p->a->col_idx + k0, o->col_idx + k0, (size_t)(k1 - k0) * sizeof(int));
+    memcpy(p->a->values + k0, o->values + k0, (size_t)(k1 - k0) * sizeof(float));
+    return NULL;
+}
+
+/*
+ * Percorre o trecho do caminho da thread: as linhas que terminam no trecho
+ * são gravadas em y; a soma parcial da linha em que o trecho termina fica em
+ * carry[id] e é somada depois que todas as threads terminam.
+ */
+static void* tarefa_spmv(void *arg) {
+    TarefaSpmv *t = (TarefaSpmv*)arg;
+    PlanoSpmv *p = t->plano;
+    const MatrixCSR *a = p->a;
+    long long t0 = timer_ns();
+
+    int i = p->linha[t->id], fim_i = p->linha[t->id + 1];
+    int k = p->pos[t->id], fim_k = p->pos[t->id + 1];
+    float soma = 0.0f;
+
+    for (; i < fim_i; i++) {
+        for (; k < a->row_ptr[i + 1]; k++) soma += a->values[k] * t->x[a->col_idx[k]];
+        t->y[i] = soma;
+        soma = 0.0f;
+    }
+    for (; k < fim_k; k++) soma += a->values[k] * t->x[a->col_idx[k]];
+
+    p->carry[t->id] = soma;
+    p->ns_thread[t->id] = timer_ns() - t0;
+    return NULL;
+}
+
+/*
+ * Threads do plano, uma por faixa, fixadas no processador da faixa (quando
+ * houver). Entre as chamadas, ficam paradas em `inicio`; cada chamada
+ * publica a rotina e os vetores nas tarefas, incrementa `geracao` e espera
+ * `pendentes` chegar a zero. As faixas cuja thread não pôde ser criada rodam
+ * na thread chamadora, então o resultado não depende disso.
+ */
+typedef struct EquipeSpmv {
+    pthread_mutex_t trava;
+    pthread_cond_t inicio;
+    pthread_cond_t fim;
+    void *(*rotina)(void*);
+    unsigned geracao;
+    int pendentes;
+    int encerrar;
+    TarefaSpmv *tarefas;
+    pthread_t *threads;
+    int *criada;
+} EquipeSpmv;
+
+static void* membro_spmv(void *arg) {
+    TarefaSpmv *tarefa = (TarefaSpmv*)arg;
+    EquipeSpmv *e = tarefa->plano->equipe;
+
+    /* começa da geração 0: a primeira chamada pode ser publicada antes de a thread chegar aqui */
+    unsigned vista = 0;
+    pthread_mutex_lock(&e->trava);
+    for (;;) {
+        while (e->geracao == vista && !e->encerrar) pthread_cond_wait(&e->inicio, &e->trava);
+        if (e->encerrar) break;
+        vista = e->geracao;
+        void *(*rotina)(void*) = e->rotina;
+        pthread_mutex_unlock(&e->trava);
+
+        rotina(tarefa);
+
+        pthread_mutex_lock(&e->trava);
+        if (--e->pendentes == 0) pthread_cond_signal(&e->fim);
+    }
+    pthread_mutex_unlock(&e->trava);
+    return NULL;
+}
+
+static void equipe_spmv_destroy(EquipeSpmv *e, int nt) {
+    if (!e) return;
+
+    pthread_mutex_lock(&e->trava);
+    e->encerrar = 1;
+    pthread_cond_broadcast(&e->inicio);
+    pthread_mutex_unlock(&e->trava);
+    for (int t = 0; t < nt; t++) {
+        if (e->criada[t]) pthread_join(e->threads[t], NULL);
+    }
+
+    pthread_mutex_destroy(&e->trava);
+    pthread_cond_destroy(&e->inicio);
+    pthread_cond_destroy(&e->fim);
+    free(e->tarefas);
+    free(e->threads);
+    free(e->criada);
+    free(e);
+}
+
+static int equipe_spmv_init(PlanoSpmv *p) {
+    int nt = p->nthreads;
+    EquipeSpmv *e = (EquipeSpmv*)calloc(1, sizeof(EquipeSpmv));
+    if (!e) return 1;
+    e->tarefas = (TarefaSpmv*)calloc((size_t)nt, sizeof(TarefaSpmv));
+    e->threads = (pthread_t*)malloc((size_t)nt * sizeof(pthread_t));
+    e->criada = (int*)calloc((size_t)nt, sizeof(int));
+    if (!e->tarefas || !e->threads || !e->criada) {
+        free(e->tarefas);
+        free(e->threads);
+        free(e->criada);
+        free(e);
+        return 1;
+    }
+    pthread_mutex_init(&e->trava, NULL);
+    pthread_cond_init(&e->inicio, NULL);
+    pthread_cond_init(&e->fim, NULL);
+    p->equipe = e;
+
+    for (int t = 0; t < nt; t++) {
+        e->tarefas[t].plano = p;
+        e->tarefas[t].id = t;
+
+        pthread_attr_t attr;
+        if (pthread_attr_init(&attr) != 0) continue;
+#ifdef __linux__
+        if (p->cpu[t] >= 0) {
+            cpu_set_t cs;
+            CPU_ZERO(&cs);
+            CPU_SET(p->cpu[t], &cs);
+            pthread_attr_setaffinity_np(&attr, sizeof(cs), &cs);
+        }
+#endif
+        e->criada[t] = pthread_create(&e->threads[t], &attr, membro_spmv, &e->tarefas[t]) == 0;
+        pthread_attr_destroy(&attr);
+    }
+    return 0;
+}
+
+/* Roda `rotina` em todas as faixas com as threads do plano e espera todas terminarem. */
+static void dispara_spmv(PlanoSpmv *p, const MatrixCSR *origem, const float *x, float *y,
+                         void *(*rotina)(void*)) {
+    EquipeSpmv *e = p->equipe;
+    int nt = p->nthreads;
+    int criadas = 0;
+
+    for (int t = 0; t < nt; t++) {
+        e->tarefas[t].origem = origem;
+        e->tarefas[t].x = x;
+        e->tarefas[t].y = y;
+        criadas += e->criada[t];
+    }
+
+    pthread_mutex_lock(&e->trava);
+    e->rotina = rotina;
+    e->pendentes = criadas;
+    e->geracao++;
+    pthread_cond_broadcast(&e->inicio);
+    pthread_mutex_unlock(&e->trava);
+
+    for (int t = 0; t < nt; t++) {
+        if (!e->criada[t]) rotina(&e->tarefas[t]);
+    }
+
+    pthread_mutex_lock(&e->trava);
+    while (e->pendentes > 0) pthread_cond_wait(&e->fim, &e->trava);
+    pthread_mutex_unlock(&e->trava);
+}
+
+/**
+ * @brief Prepara o SpMV paralelo de uma matriz CSR.
+ *
+ * Divide o caminho de intercalação de A (linhas + nnz passos) em `nthreads`
+ * trechos iguais (merge path): cada thread recebe o mesmo número de elementos
+ * mais fins de linha, mesmo que uma linha sozinha tenha boa parte dos não
+ * nulos (ela é então dividida entre threads). Em seguida, copia A para o
+ * plano com cada thread escrevendo a própria faixa (first touch), de modo
+ * que, em máquinas NUMA, as páginas de cada faixa fiquem no nó da thread que
+ * vai lê-las. No Linux, se houver processadores suficientes, a thread t é
+ * fixada no t-ésimo processador permitido ao processo. As threads são
+ * criadas aqui, fazem a cópia e ficam paradas à espera de cada
+ * `csr_spmv_parallel`, até `plano_spmv_destroy`.
+ *
+ * @param a Ponteiro constante para a matriz CSR (não é referenciada depois).
+ * @param nthreads Número de threads (<= 0 usa todos os processadores).
+ * @param p Endereço de ponteiro que receberá o plano.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*p` aponta para um novo plano; em erro, `*p` permanece NULL.
+ */
+int plano_spmv_init(const MatrixCSR *a, int nthreads, PlanoSpmv **p) {
+    if (!a || !p) return 1;
+    *p = NULL;
+
+    nthreads = parallel_num_threads(nthreads);
+    PlanoSpmv *pl = (PlanoSpmv*)calloc(1, sizeof(PlanoSpmv));
+    if (!pl) return 1;
+
+    pl->nthreads = nthreads;
+    pl->a = csr_init(a->linhas, a->colunas, a->nnz);
+    pl->linha = (int*)malloc(((size_t)nthreads + 1) * sizeof(int));
+    pl->pos = (int*)malloc(((size_t)nthreads + 1) * sizeof(int));
+    pl->cpu = (int*)malloc((size_t)nthreads * sizeof(int));
+    pl->carry = (float*)malloc((size_t)nthreads * sizeof(float));
+    pl->ns_thread = (long long*)calloc((size_t)nthreads, sizeof(long long));
+    if (!pl->a || !pl->linha || !pl->pos || !pl->cpu || !pl->carry || !pl->ns_thread) {
+        plano_spmv_destroy(pl);
+        return 1;
+    }
+
+    long long total = (long long)a->linhas + a->nnz;
+    for (int t = 0; t <= nthreads; t++) {
+        merge_path(a->row_ptr, a->linhas, a->nnz, total * t / nthreads, &pl->linha[t], &pl->pos[t]);
+    }
+
+    for (int t = 0; t < nthreads; t++) pl->cpu[t] = -1;
+#ifdef __linux__
+    cpu_set_t permitidos;
+    if (sched_getaffinity(0, sizeof(permitidos), &permitidos) == 0 && CPU_COUNT(&permitidos) >= nthreads) {
+        int t = 0;
+        for (int c = 0; c < CPU_SETSIZE && t < nthreads; c++) {
+            if (CPU_ISSET(c, &permitidos)) pl->cpu[t++] = c;
+        }
+    }
+#endif
+
+    if (equipe_spmv_init(pl)) {
+        plano_spmv_destroy(pl);
+        return 1;
+    }
+    dispara_spmv(pl, a, NULL, NULL, tarefa_spmv_copia);
+    pl->a->row_ptr[a->linhas] = a->row_ptr[a->linhas];
+
+    *p = pl;
+    return 0;
+}
+
+/**
+ * @brief Encerra as threads e libera um plano criado por `plano_spmv_init`.
+ *
+ * @param p Ponteiro para o plano (pode ser NULL).
+ */
+void plano_spmv_destroy(PlanoSpmv *p) {
+    if (!p) return;
+
+    equipe_spmv_destroy(p->equipe, p->nthreads);
+    csr_destroy(p->a);
+    free(p->linha);
+    free(p->pos);
+    free(p->cpu);
+    free(p->carry);
+    free(p->ns_thread);
+    free(p);
+}
+
+/**
+ * @brief Produto matriz-vetor y = A * x em paralelo, com o plano de `plano_spmv_init`.
+ *
+ * Cada thread percorre o seu trecho do caminho de intercalação; as linhas
+ * divididas entre threads são completadas ao final com as somas parciais.
+ * O tempo de cada thread fica em p->ns_thread[t], para verificar o balanço.
+ * A ordem das somas difere de `csr_spmv`, então os resultados podem diferir
+ * no último bit. Um mesmo plano não deve ser usado por duas chamadas ao mesmo
+ * tempo.
+ *
+ * @param p Plano do SpMV.
+ * @param x Vetor denso com a->colunas posições.
+ * @param y Vetor denso com a->linhas posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int csr_spmv_parallel(PlanoSpmv *p, const float *x, float *y) {
+    if (!p || !x || !y) return 1;
+
+    dispara_spmv(p, NULL, x, y, tarefa_spmv);
+
+    for (int t = 0; t < p->nthreads; t++) {
+        int i = p->linha[t + 1];
+        if (i < p->a->linhas) y[i] += p->carry[t];
+    }
+    return 0;
+}
+
+/* ===== SpMM paralelo (CSR) ===== */
+
+typedef struct TarefaSpmm {
+    KernelSpmm kernel;
+    const MatrixCSR *a;
+    const float *b;
+    float *c;
+    int k;
+    int ldb;
+    int ldc;
+    int ini;
+    int fim;
+} TarefaSpmm;
+
+static void* tarefa_spmm(void *arg) {
+    TarefaSpmm *t = (TarefaSpmm*)arg;
+    t->kernel(t->a, t->b, t->k, t->ldb, t->c, t->ldc, t->ini, t->fim);
+    return NULL;
+}
+
+/**
+ * @brief Versão paralela de `csr_spmm`.
+ *
+ * As linhas de A são divididas entre as threads pelo número de não nulos
+ * (mais um por linha); cada thread grava apenas as suas linhas de C, com o
+ * mesmo kernel de `csr_spmm` (escolhido uma vez, na thread chamadora), então
+ * o resultado é idêntico. Se a criação de uma thread falhar, a faixa dela
+ * roda na thread chamadora.
+ *
+ * @param a Ponteiro constante para a matriz CSR (linhas x colunas).
+ * @param b Matriz densa (a->colunas x k), por linha, com passo `ldb`.
+ * @param k Número de colunas de B e C (> 0).
+ * @param ldb Passo entre linhas de B (>= k).
+ * @param c Matriz densa (a->linhas x k), por linha, com passo `ldc` (sobrescrita).
+ * @param ldc Passo entre linhas de C (>= k).
+ * @param nthreads Número de threads (<= 0 usa todos os processadores).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se k <= 0, se ldb/ldc < k ou se
+ *         falhar alguma alocação.
+ */
+int csr_spmm_parallel(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int nthreads) {
+    if (!a || !b || !c) return 1;
+    if (k <= 0 || ldb < k || ldc < k) return 1;
+
+    nthreads = parallel_num_threads(nthreads);
+    if (nthreads > a->linhas) nthreads = a->linhas;
+    if (nthreads <= 1) return csr_spmm(a, b, k, ldb, c, ldc);
+
+    long long *prefixo = (long long*)malloc(((size_t)a->linhas + 1) * sizeof(long long));
+    int *limites = (int*)malloc(((size_t)nthreads + 1) * sizeof(int));
+    TarefaSpmm *tarefas = (TarefaSpmm*)malloc((size_t)nthreads * sizeof(TarefaSpmm));
+    pthread_t *threads = (pthread_t*)malloc((size_t)nthreads * sizeof(pthread_t));
+    int *criada = (int*)calloc((size_t)nthreads, sizeof(int));
+    if (!prefixo || !limites || !tarefas || !threads || !criada) {
+        free(prefixo);
+        free(limites);
+        free(tarefas);
+        free(threads);
+        free(criada);
+        return 1;
+    }
+
+    for (int i = 0; i <= a->linhas; i++) prefixo[i] = (long long)a->row_ptr[i] + i;
+    parallel_partition(prefixo, a->linhas, nthreads, limites);
+
+    /* o kernel é escolhido uma vez, aqui, e não por cada thread */
+    KernelSpmm kernel = csr_spmm_kernel(k);
+    for (int t = 0; t < nthreads; t++) {
+        tarefas[t] = (TarefaSpmm){kernel, a, b, c, k, ldb, ldc, limites[t], limites[t + 1]};
+
+        /* A última faixa roda na própria thread chamadora. */
+        if (t < nthreads - 1) criada[t] = pthread_create(&threads[t], NULL, tarefa_spmm, &tarefas[t]) == 0;
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        if (!criada[t]) tarefa_spmm(&tarefas[t]);
+    }
+    for (int t = 0; t < nthreads; t++) {
+        if (criada[t]) pthread_join(threads[t], NULL);
+    }
+
+    free(prefixo);
+    free(limites);
+    free(tarefas);
+    free(threads);
+    free(criada);
+    return 0;
+}
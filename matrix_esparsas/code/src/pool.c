@@ -0,0 +1,171 @@
+#include <stdlib.h>
+#include "pool.h"
+
+#define POOL_SLAB_MIN 64
+#define POOL_SLAB_MAX 65536
+
+static Slab* novo_slab(NoPool *p, int capacidade) {
+    Slab *s = (Slab*)malloc(sizeof(Slab) + (size_t)capacidade * sizeof(No));
+    if (!s) return NULL;
+
+    s->capacidade = capacidade;
+    s->usados = 0;
+    s->prox = p->slabs;
+    p->slabs = s;
+    p->nslabs++;
+    return s;
+}
+
+/**
+ * @brief Inicializa um alocador de nós vazio.
+ *
+ * Nenhuma memória é alocada até o primeiro `pool_alloc`/`pool_reserve`.
+ *
+ * @param p Ponteiro para o alocador.
+ */
+void pool_init(NoPool *p) {
+    if (!p) return;
+
+    p->slabs = NULL;
+    p->livres = NULL;
+    p->proximo_tam = POOL_SLAB_MIN;
+    p->nslabs = 0;
+    p->alocados = 0;
+    p->liberados = 0;
+}
+
+/**
+ * @brief Libera todos os slabs do alocador.
+ *
+ * Todos os nós obtidos do alocador deixam de ser válidos. O custo é
+ * proporcional ao número de slabs, e não ao número de nós.
+ *
+ * @param p Ponteiro para o alocador.
+ *
+ * @post O alocador volta ao estado de `pool_init`.
+ */
+void pool_destroy(NoPool *p) {
+    if (!p) return;
+
+    Slab *s = p->slabs;
+    while (s) {
+        Slab *prox = s->prox;
+        free(s);
+        s = prox;
+    }
+    pool_init(p);
+}
+
+/**
+ * @brief Obtém um nó do alocador.
+ *
+ * Reaproveita primeiro os nós devolvidos por `pool_free`; depois usa o espaço
+ * restante do slab atual e, se ele estiver cheio, aloca um novo slab com o
+ * dobro do tamanho do anterior (até POOL_SLAB_MAX nós).
+ *
+ * @param p Ponteiro para o alocador.
+ *
+ * @return Ponteiro para um nó não inicializado.
+ * @return NULL se `p` for NULL ou se falhar a alocação de um slab.
+ */
+No* pool_alloc(NoPool *p) {
+    if (!p) return NULL;
+
+    No *no = p->livres;
+    if (no) {
+        p->livres = no->prox;
+        p->alocados++;
+        return no;
+    }
+
+    Slab *s = p->slabs;
+    if (!s || s->usados == s->capacidade) {
+        s = novo_slab(p, p->proximo_tam);
+        if (!s) return NULL;
+        if (p->proximo_tam < POOL_SLAB_MAX) p->proximo_tam *= 2;
+    }
+
+    p->alocados++;
+    return &s->nos[s->usados++];
+}
+
+/**
+ * @brief Devolve um nó ao alocador para ser reaproveitado.
+ *
+ * @param p Ponteiro para o alocador de onde o nó foi obtido.
+ * @param no Nó a ser devolvido.
+ */
+void pool_free(NoPool *p, No *no) {
+    if (!p || !no) return;
+
+    no->prox = p->livres;
+    p->livres = no;
+    p->liberados++;
+}
+
+/**
+ * @brief Garante que os próximos `n` nós do slab atual sejam contíguos.
+ *
+ * Se o slab atual não tiver `n` posições livres, aloca um novo slab com pelo
+ * menos `n` nós. Usado pelos construtores de linhas/matrizes para obter os nós
+ * de um resultado com uma única alocação.
+ *
+ * @param p Ponteiro para o alocador.
+ * @param n Número de nós que serão alocados em seguida.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `p` for NULL ou se falhar a alocação.
+ */
+int pool_reserve(NoPool *p, int n) {
+    if (!p) return 1;
+    if (n <= 0) return 0;
+
+    Slab *s = p->slabs;
+    if (s && s->capacidade - s->usados >= n) return 0;
+
+    int capacidade = n > p->proximo_tam ? n : p->proximo_tam;
+    if (!novo_slab(p, capacidade)) return 1;
+    if (p->proximo_tam < POOL_SLAB_MAX) p->proximo_tam *= 2;
+    return 0;
+}
+
+/**
+ * @brief Transfere os slabs e os nós livres de `src` para `dst`.
+ *
+ * Usado quando uma matriz é montada com alocadores separados (um por thread):
+ * ao final, todos os nós passam a pertencer ao alocador da matriz.
+ *
+ * @param dst Alocador que recebe os slabs.
+ * @param src Alocador de origem; volta ao estado de `pool_init`.
+ */
+void pool_merge(NoPool *dst, NoPool *src) {
+    if (!dst || !src || dst == src) return;
+
+    /* Os slabs de src entram depois do slab atual de dst, que continua sendo usado. */
+    Slab *ultimo = src->slabs;
+    if (ultimo) {
+        while (ultimo->prox) ultimo = ultimo->prox;
+        if (dst->slabs) {
+            ultimo->prox = dst->slabs->prox;
+            dst->slabs->prox = src->slabs;
+        } else {
+            dst->slabs = src->slabs;
+        }
+    }
+
+    No *livre = src->livres;
+    while (livre) {
+        No *prox = livre->prox;
+        livre->prox = dst->livres;
+        dst->livres = livre;
+        livre = prox;
+    }
+
+    dst->nslabs += src->nslabs;
+    dst->alocados += src->alocados;
+    dst->liberados += src->liberados;
+
+    src->slabs = NULL;
+    src->livres = NULL;
+    pool_init(src);
+}
@@ -0,0 +1,477 @@
+#include <stdlib.h>
+#include <string.h>
+#include "reorder.h"
+#include "create.h"
+#include "pool.h"
+
+/*
+ * Grafo de adjacência de A + Aᵀ, sem a diagonal e sem arestas repetidas.
+ * Os vizinhos de cada vértice estão em ordem crescente de grau, e `ordem`
+ * lista os vértices por grau crescente (empates pelo índice).
+ */
+typedef struct Grafo {
+    int n;
+    int *ptr;
+    int *adj;
+    int *grau;
+    int *ordem;
+} Grafo;
+
+typedef struct Par {
+    int coluna;
+    float valor;
+} Par;
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_par(const void *a, const void *b) {
+    int x = ((const Par*)a)->coluna;
+    int y = ((const Par*)b)->coluna;
+    return (x > y) - (x < y);
+}
+
+static void grafo_free(Grafo *g) {
+    free(g->ptr);
+    free(g->adj);
+    free(g->grau);
+    free(g->ordem);
+}
+
+static int grafo_simetrico(const Matrix *m, Grafo *g) {
+    int n = m->linhas;
+    memset(g, 0, sizeof(Grafo));
+    g->n = n;
+    if (n <= 0) return 1;
+
+    long long arestas = 0;
+    for (int i = 0; i < n; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            if (p->coluna - 1 != i) arestas += 2;
+        }
+    }
+    if (arestas > 0x7fffffff) return 1;
+
+    int *cnt = (int*)calloc((size_t)n + 1, sizeof(int));
+    int *tmp = (int*)malloc((arestas ? (size_t)arestas : 1) * sizeof(int));
+    g->ptr = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    g->grau = (int*)calloc((size_t)n, sizeof(int));
+    g->ordem = (int*)malloc((size_t)n * sizeof(int));
+    if (!cnt || !tmp || !g->ptr || !g->grau || !g->ordem) {
+        free(cnt);
+        free(tmp);
+        grafo_free(g);
+        return 1;
+    }
+
+    /* 1) todas as arestas (i, j) e (j, i), com repetições */
+    for (int i = 0; i < n; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            int j = p->coluna - 1;
+            if (j == i) continue;
+            cnt[i + 1]++;
+            cnt[j + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) cnt[i + 1] += cnt[i];
+    memcpy(g->ptr, cnt, ((size_t)n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        for (POINT p = m->mat[i]; p; p = p->prox) {
+            int j = p->coluna - 1;
+            if (j == i) continue;
+            tmp[cnt[i]++] = j;
+            tmp[cnt[j]++] = i;
+        }
+    }
+
+    /* 2) remove repetições: os vizinhos únicos de i ficam no início do trecho */
+    for (int i = 0; i < n; i++) {
+        int *v = tmp + g->ptr[i];
+        int len = g->ptr[i + 1] - g->ptr[i];
+        qsort(v, (size_t)len, sizeof(int), cmp_int);
+        int u = 0;
+        for (int t = 0; t < len; t++) {
+            if (u == 0 || v[t] != v[u - 1]) v[u++] = v[t];
+        }
+        g->grau[i] = u;
+    }
+
+    /* 3) vértices por grau crescente (contagem) */
+    memset(cnt, 0, ((size_t)n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) cnt[g->grau[i] + 1]++;
+    for (int d = 0; d < n; d++) cnt[d + 1] += cnt[d];
+    for (int i = 0; i < n; i++) g->ordem[cnt[g->grau[i]]++] = i;
+
+    /*
+     * 4) lista final: percorrer as origens por grau crescente deixa os
+     * vizinhos de cada vértice já ordenados por grau.
+     */
+    int total = 0;
+    for (int i = 0; i < n; i++) total += g->grau[i];
+    g->adj = (int*)malloc((total ? (size_t)total : 1) * sizeof(int));
+    if (!g->adj) {
+        free(cnt);
+        free(tmp);
+        grafo_free(g);
+        return 1;
+    }
+
+    int *orig = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    if (!orig) {
+        free(cnt);
+        free(tmp);
+        grafo_free(g);
+        return 1;
+    }
+    memcpy(orig, g->ptr, ((size_t)n + 1) * sizeof(int));
+
+    g->ptr[0] = 0;
+    for (int i = 0; i < n; i++) g->ptr[i + 1] = g->ptr[i] + g->grau[i];
+    memcpy(cnt, g->ptr, (size_t)n * sizeof(int));
+    for (int t = 0; t < n; t++) {
+        int u = g->ordem[t];
+        for (int k = orig[u]; k < orig[u] + g->grau[u]; k++) g->adj[cnt[tmp[k]]++] = u;
+    }
+
+    free(orig);
+    free(cnt);
+    free(tmp);
+    return 0;
+}
+
+/*
+ * Busca em largura a partir de `raiz`, marcando com `selo` em `marca`.
+ * Deixa os vértices do componente em `fila`, em ordem de nível, e retorna o
+ * número de vértices; o número de níveis fica em *niveis.
+ */
+static int bfs_niveis(const Grafo *g, int raiz, int *marca, int selo, int *fila, int *nivel, int *niveis) {
+    int ini = 0, fim = 0;
+    fila[fim++] = raiz;
+    marca[raiz] = selo;
+    nivel[raiz] = 0;
+
+    while (ini < fim) {
+        int u = fila[ini++];
+        for (int k = g->ptr[u]; k < g->ptr[u + 1]; k++) {
+            int v = g->adj[k];
+            if (marca[v] == selo) continue;
+            marca[v] = selo;
+            nivel[v] = nivel[u] + 1;
+            fila[fim++] = v;
+        }
+    }
+    *niveis = nivel[fila[fim - 1]] + 1;
+    return fim;
+}
+
+/*
+ * Vértice pseudo-periférico (George e Liu): repete a busca em largura a
+ * partir do vértice de menor grau do último nível enquanto a excentricidade
+ * aumentar.
+ */
+static int pseudo_periferico(const Grafo *g, int raiz, int *marca, int *selo, int *fila, int *nivel) {
+    int niveis;
+    int tam = bfs_niveis(g, raiz, marca, ++(*selo), fila, nivel, &niveis);
+
+    for (;;) {
+        int melhor = -1;
+        for (int t = tam - 1; t >= 0 && nivel[fila[t]] == niveis - 1; t--) {
+            if (melhor < 0 || g->grau[fila[t]] < g->grau[melhor]) melhor = fila[t];
+        }
+
+        int niveis_novo;
+        bfs_niveis(g, melhor, marca, ++(*selo), fila, nivel, &niveis_novo);
+        if (niveis_novo <= niveis) return raiz;
+
+        raiz = melhor;
+        niveis = niveis_novo;
+    }
+}
+
+/**
+ * @brief Calcula a ordem Reverse Cuthill-McKee de uma matriz quadrada.
+ *
+ * Usa a estrutura de A + Aᵀ (a matriz não precisa ser simétrica). Cada
+ * componente conexo começa em um vértice pseudo-periférico e é percorrido em
+ * largura, visitando os vizinhos por grau crescente; a ordem final é
+ * invertida. Custo O(nnz log nnz) para montar o grafo e O(nnz) por busca.
+ *
+ * @param m Ponteiro constante para a matriz (n x n).
+ * @param perm Vetor com n posições; recebe a permutação: a nova linha i é a
+ *             linha perm[i] de A (base 0).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a matriz não for quadrada
+ *         ou se falhar alguma alocação.
+ */
+int reorder_rcm(const Matrix *m, int *perm) {
+    if (!m || !m->mat || !perm) return 1;
+    if (m->linhas != m->colunas) return 1;
+
+    int n = m->linhas;
+    Grafo g;
+    if (grafo_simetrico(m, &g)) return 1;
+
+    int *marca = (int*)calloc((size_t)n, sizeof(int));
+    int *fila = (int*)malloc((size_t)n * sizeof(int));
+    int *nivel = (int*)malloc((size_t)n * sizeof(int));
+    char *visitado = (char*)calloc((size_t)n, 1);
+    if (!marca || !fila || !nivel || !visitado) {
+        free(marca);
+        free(fila);
+        free(nivel);
+        free(visitado);
+        grafo_free(&g);
+        return 1;
+    }
+
+    int k = 0, cursor = 0, selo = 0;
+    while (k < n) {
+        while (visitado[g.ordem[cursor]]) cursor++;
+        int raiz = pseudo_periferico(&g, g.ordem[cursor], marca, &selo, fila, nivel);
+
+        int cab = k;
+        perm[k++] = raiz;
+        visitado[raiz] = 1;
+        while (cab < k) {
+            int u = perm[cab++];
+            for (int t = g.ptr[u]; t < g.ptr[u + 1]; t++) {
+                int v = g.adj[t];
+                if (visitado[v]) continue;
+                visitado[v] = 1;
+                perm[k++] = v;
+            }
+        }
+    }
+
+    for (int i = 0, j = n - 1; i < j; i++, j--) {
+        int t = perm[i];
+        perm[i] = perm[j];
+        perm[j] = t;
+    }
+
+    free(marca);
+    free(fila);
+    free(nivel);
+    free(visitado);
+    grafo_free(&g);
+    return 0;
+}
+
+/**
+ * @brief Calcula a ordem por grau crescente (em A + Aᵀ) de uma matriz quadrada.
+ *
+ * Mais barata que a RCM; empates ficam na ordem original.
+ *
+ * @param m Ponteiro constante para a matriz (n x n).
+ * @param perm Vetor com n posições; recebe a permutação (ver `reorder_rcm`).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a matriz não for quadrada
+ *         ou se falhar alguma alocação.
+ */
+int reorder_degree(const Matrix *m, int *perm) {
+    if (!m || !m->mat || !perm) return 1;
+    if (m->linhas != m->colunas) return 1;
+
+    Grafo g;
+    if (grafo_simetrico(m, &g)) return 1;
+
+    memcpy(perm, g.ordem, (size_t)m->linhas * sizeof(int));
+    grafo_free(&g);
+    return 0;
+}
+
+/**
+ * @brief Aplica a permutação simétrica B = P A Pᵀ: B(i, j) = A(perm[i], perm[j]).
+ *
+ * Cada linha de B é montada a partir da linha perm[i] de A, com as colunas
+ * renumeradas e ordenadas. Todos os nós são reservados de uma vez.
+ *
+ * @param m Ponteiro constante para A (n x n).
+ * @param perm Permutação de 0 .. n - 1 (base 0).
+ * @param r Endereço de ponteiro que receberá B.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a matriz não for quadrada
+ *         ou se falhar alguma alocação.
+ * @return 2 se `perm` não for uma permutação de 0 .. n - 1.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_permute(const Matrix *m, const int *perm, Matrix **r) {
+    if (!m || !m->mat || !perm || !r) return 1;
+    *r = NULL;
+    if (m->linhas != m->colunas) return 1;
+
+    int n = m->linhas;
+    int *inv = (int*)malloc((size_t)n * sizeof(int));
+    if (!inv) return 1;
+    for (int i = 0; i < n; i++) inv[i] = -1;
+
+    for (int i = 0; i < n; i++) {
+        if (perm[i] < 0 || perm[i] >= n || inv[perm[i]] != -1) {
+            free(inv);
+            return 2;
+        }
+        inv[perm[i]] = i;
+    }
+
+    long long nnz = 0;
+    int maior = 0;
+    for (int i = 0; i < n; i++) {
+        int len = 0;
+        for (POINT p = m->mat[i]; p; p = p->prox) len++;
+        nnz += len;
+        if (len > maior) maior = len;
+    }
+
+    Matrix *res = init_matrix(n, n);
+    Par *linha = (Par*)malloc((maior ? (size_t)maior : 1) * sizeof(Par));
+    if (!res || !linha || nnz > 0x7fffffff || pool_reserve(&res->pool, (int)nnz)) {
+        matrix_destroy(res);
+        free(linha);
+        free(inv);
+        return 1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        int len = 0;
+        for (POINT p = m->mat[perm[i]]; p; p = p->prox) {
+            linha[len].coluna = inv[p->coluna - 1] + 1;
+            linha[len].valor = p->valor;
+            len++;
+        }
+        qsort(linha, (size_t)len, sizeof(Par), cmp_par);
+
+        POINT *cauda = &res->mat[i];
+        for (int t = 0; t < len; t++) {
+            No *novo = pool_alloc(&res->pool);
+            novo->coluna = linha[t].coluna;
+            novo->valor = linha[t].valor;
+            novo->prox = NULL;
+            *cauda = novo;
+            cauda = &novo->prox;
+        }
+    }
+
+    free(linha);
+    free(inv);
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Calcula a largura de banda e o perfil de uma matriz quadrada.
+ *
+ * A banda é o maior |i - j| entre os elementos armazenados. O perfil é a
+ * soma, sobre as linhas, da distância entre a diagonal e o primeiro elemento
+ * à esquerda dela (0 se a linha não tiver elemento abaixo da diagonal).
+ *
+ * @param m Ponteiro constante para a matriz.
+ * @param banda Recebe a largura de banda (pode ser NULL).
+ * @param perfil Recebe o perfil (pode ser NULL).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se `m` for NULL ou se a matriz não for quadrada.
+ */
+int matrix_bandwidth(const Matrix *m, int *banda, long long *perfil) {
+    if (!m || !m->mat) return 1;
+    if (m->linhas != m->colunas) return 1;
+
+    int b = 0;
+    long long pf = 0;
+    for (int i = 0; i < m->linhas; i++) {
+        POINT p = m->mat[i];
+        if (!p) continue;
+
+        int primeira = p->coluna - 1;
+        if (primeira < i) pf += i - primeira;
+        if (i - primeira > b) b = i - primeira;
+
+        while (p->prox) p = p->prox;
+        if (p->coluna - 1 - i > b) b = p->coluna - 1 - i;
+    }
+
+    if (banda) *banda = b;
+    if (perfil) *perfil = pf;
+    return 0;
+}
+
+/**
+ * @brief Calcula uma ordem, aplica a permutação simétrica e relata banda e perfil.
+ *
+ * Equivale a `reorder_rcm` (ou `reorder_degree`) seguido de `matrix_permute`.
+ * Para resolver A x = b com B = P A Pᵀ: resolva B x' = P b (`vector_permute`)
+ * e recupere x = Pᵀ x' (`vector_unpermute`).
+ *
+ * @param m Ponteiro constante para A (n x n).
+ * @param tipo ORDEM_RCM ou ORDEM_GRAU.
+ * @param perm Vetor com n posições; recebe a permutação usada.
+ * @param r Endereço de ponteiro que receberá B = P A Pᵀ.
+ * @param rel Se não for NULL, recebe banda e perfil antes e depois.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a matriz não for quadrada, se o
+ *         tipo for inválido ou se falhar alguma alocação.
+ *
+ * @post Em sucesso, `*r` aponta para uma nova matriz; em erro, `*r` permanece NULL.
+ */
+int matrix_reorder(const Matrix *m, OrdemTipo tipo, int *perm, Matrix **r, RelatorioOrdem *rel) {
+    if (!r) return 1;
+    *r = NULL;
+
+    int erro;
+    if (tipo == ORDEM_RCM) erro = reorder_rcm(m, perm);
+    else if (tipo == ORDEM_GRAU) erro = reorder_degree(m, perm);
+    else erro = 1;
+    if (erro) return erro;
+
+    erro = matrix_permute(m, perm, r);
+    if (erro) return erro;
+
+    if (rel) {
+        matrix_bandwidth(m, &rel->banda_antes, &rel->perfil_antes);
+        matrix_bandwidth(*r, &rel->banda_depois, &rel->perfil_depois);
+    }
+    return 0;
+}
+
+/**
+ * @brief Leva um vetor para a nova ordem: y[i] = x[perm[i]].
+ *
+ * @param x Vetor na ordem original, com n posições.
+ * @param perm Permutação (base 0).
+ * @param n Número de posições.
+ * @param y Vetor na nova ordem (sobrescrito; não pode ser `x`).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int vector_permute(const float *x, const int *perm, int n, float *y) {
+    if (!x || !perm || !y) return 1;
+
+    for (int i = 0; i < n; i++) y[i] = x[perm[i]];
+    return 0;
+}
+
+/**
+ * @brief Desfaz a permutação de um vetor: x[perm[i]] = y[i].
+ *
+ * @param y Vetor na nova ordem, com n posições.
+ * @param perm Permutação (base 0).
+ * @param n Número de posições.
+ * @param x Vetor na ordem original (sobrescrito; não pode ser `y`).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int vector_unpermute(const float *y, const int *perm, int n, float *x) {
+    if (!y || !perm || !x) return 1;
+
+    for (int i = 0; i < n; i++) x[perm[i]] = y[i];
+    return 0;
+}
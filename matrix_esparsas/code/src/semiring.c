@@ -0,0 +1,57 @@
+#include "semiring.h"
+
+/*
+ * Instancia os produtos de semiring_modelo.h para os semianéis prontos.
+ * O infinito vem de __builtin_inff() porque code/include/math.h encobre o
+ * <math.h> do sistema.
+ */
+
+#define SR_SUF plus_times
+#define SR_ACUM double
+#define SR_ZERO 0.0
+#define SR_SOMA(x, y) ((x) + (y))
+#define SR_PRODUTO(x, y) ((x) * (y))
+#include "semiring_modelo.h"
+#undef SR_SUF
+#undef SR_ACUM
+#undef SR_ZERO
+#undef SR_SOMA
+#undef SR_PRODUTO
+
+#define SR_SUF min_plus
+#define SR_ACUM float
+#define SR_ZERO __builtin_inff()
+#define SR_SOMA(x, y) ((x) < (y) ? (x) : (y))
+#define SR_PRODUTO(x, y) ((x) + (y))
+#include "semiring_modelo.h"
+#undef SR_SUF
+#undef SR_ACUM
+#undef SR_ZERO
+#undef SR_SOMA
+#undef SR_PRODUTO
+
+#define SR_SUF max_times
+#define SR_ACUM float
+#define SR_ZERO (-__builtin_inff())
+#define SR_SOMA(x, y) ((x) > (y) ? (x) : (y))
+#define SR_PRODUTO(x, y) ((x) * (y))
+#include "semiring_modelo.h"
+#undef SR_SUF
+#undef SR_ACUM
+#undef SR_ZERO
+#undef SR_SOMA
+#undef SR_PRODUTO
+
+#define SR_SUF lor_land
+#define SR_ACUM float
+#define SR_ZERO 0.0f
+#define SR_SOMA(x, y) ((float)((x) != 0.0f || (y) != 0.0f))
+#define SR_PRODUTO(x, y) ((float)((x) != 0.0f && (y) != 0.0f))
+#define SR_TERMINAL 1.0f
+#include "semiring_modelo.h"
+#undef SR_SUF
+#undef SR_ACUM
+#undef SR_ZERO
+#undef SR_SOMA
+#undef SR_PRODUTO
+#undef SR_TERMINAL
@@ -0,0 +1,61 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include "simd.h"
+
+/*
+ * A detecção roda uma única vez (pthread_once) e o nível atual é atômico, já
+ * que simd_nivel pode ser chamada ao mesmo tempo por várias threads.
+ */
+static pthread_once_t deteccao = PTHREAD_ONCE_INIT;
+static int nivel_detectado = SIMD_ESCALAR;
+static _Atomic int nivel_atual = -1;
+
+static SimdNivel detecta(void) {
+#if SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SIMD_AVX2;
+#endif
+    return SIMD_ESCALAR;
+}
+
+static void inicia_deteccao(void) {
+    nivel_detectado = (int)detecta();
+}
+
+/**
+ * @brief Retorna o nível de SIMD usado pelos kernels com despacho em tempo de execução.
+ *
+ * Na primeira chamada detecta o que a CPU suporta (AVX-512F, AVX2 + FMA ou nenhum).
+ *
+ * @return Nível atual (o detectado, ou o escolhido por `simd_set_nivel`).
+ */
+SimdNivel simd_nivel(void) {
+    pthread_once(&deteccao, inicia_deteccao);
+    int nivel = atomic_load_explicit(&nivel_atual, memory_order_relaxed);
+    return (SimdNivel)(nivel < 0 ? nivel_detectado : nivel);
+}
+
+/**
+ * @brief Força um nível de SIMD (para testes e medições).
+ *
+ * O nível pedido é limitado ao que a CPU suporta.
+ *
+ * @param nivel Nível desejado.
+ *
+ * @return Nível efetivamente adotado.
+ */
+SimdNivel simd_set_nivel(SimdNivel nivel) {
+    pthread_once(&deteccao, inicia_deteccao);
+    int adotado = (int)nivel > nivel_detectado ? nivel_detectado : (int)nivel;
+    atomic_store_explicit(&nivel_atual, adotado, memory_order_relaxed);
+    return (SimdNivel)adotado;
+}
+
+const char* simd_nome(SimdNivel nivel) {
+    switch (nivel) {
+        case SIMD_AVX512: return "avx512";
+        case SIMD_AVX2: return "avx2";
+        default: return "escalar";
+    }
+}
@@ -0,0 +1,454 @@
+#include <stdlib.h>
+#include <string.h>
+#include "solver.h"
+#include "csr.h"
+#include "spmv.h"
+#include "timer.h"
+
+/* Produto interno acumulado em double. */
+static double dot(const float *a, const float *b, int n) {
+    double s = 0.0;
+    for (int i = 0; i < n; i++) s += (double)a[i] * b[i];
+    return s;
+}
+
+static double norma(const float *a, int n) {
+    return __builtin_sqrt(dot(a, a, n));
+}
+
+/**
+ * @brief Monta um pré-condicionador para a matriz quadrada A.
+ *
+ * - PRECOND_NENHUM: M = I (apenas copia o resíduo).
+ * - PRECOND_JACOBI: M = diag(A).
+ * - PRECOND_ILU0: fatoração LU incompleta sem preenchimento (L e U com a
+ *   mesma estrutura de A), na variante IKJ. Exige colunas ordenadas em cada
+ *   linha, como as produzidas por `csr_from_matrix`.
+ *
+ * @param a Ponteiro constante para A (n x n).
+ * @param tipo Tipo do pré-condicionador.
+ * @param p Endereço de ponteiro que receberá o pré-condicionador.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se A não for quadrada, se o tipo for
+ *         inválido ou se falhar alguma alocação.
+ * @return 2 se faltar algum elemento da diagonal ou se surgir pivô nulo.
+ *
+ * @post Em sucesso, `*p` aponta para um novo pré-condicionador; em erro, `*p` permanece NULL.
+ */
+int precond_init(const MatrixCSR *a, PrecondTipo tipo, Precondicionador **p) {
+    if (!a || !p) return 1;
+    *p = NULL;
+    if (a->linhas != a->colunas) return 1;
+    if (tipo != PRECOND_NENHUM && tipo != PRECOND_JACOBI && tipo != PRECOND_ILU0) return 1;
+
+    int n = a->linhas;
+    Precondicionador *pc = (Precondicionador*)calloc(1, sizeof(Precondicionador));
+    if (!pc) return 1;
+    pc->tipo = tipo;
+    pc->n = n;
+
+    int erro = 0;
+    if (tipo == PRECOND_JACOBI) {
+        pc->diag_inv = (float*)malloc((size_t)n * sizeof(float));
+        if (!pc->diag_inv) erro = 1;
+
+        for (int i = 0; i < n && !erro; i++) {
+            float d = 0.0f;
+            for (int k = a->row_ptr[i]; k < a->row_ptr[i + 1]; k++) {
+                if (a->col_idx[k] == i) d = a->values[k];
+            }
+            if (d == 0.0f) erro = 2;
+            else pc->diag_inv[i] = 1.0f / d;
+        }
+    } else if (tipo == PRECOND_ILU0) {
+        pc->lu = csr_init(n, n, a->nnz);
+        pc->pos_diag = (int*)malloc((size_t)n * sizeof(int));
+        int *pos = (int*)malloc((size_t)n * sizeof(int));
+        if (!pc->lu || !pc->pos_diag || !pos) erro = 1;
+
+        if (!erro) {
+            MatrixCSR *lu = pc->lu;
+            memcpy(lu->row_ptr, a->row_ptr, ((size_t)n + 1) * sizeof(int));
+            memcpy(lu->col_idx, a->col_idx, (size_t)a->nnz * sizeof(int));
+            memcpy(lu->values, a->values, (size_t)a->nnz * sizeof(float));
+
+            for (int j = 0; j < n; j++) pos[j] = -1;
+            for (int i = 0; i < n && !erro; i++) {
+                pc->pos_diag[i] = -1;
+                for (int k = lu->row_ptr[i]; k < lu->row_ptr[i + 1]; k++) {
+                    if (lu->col_idx[k] == i) pc->pos_diag[i] = k;
+                }
+                if (pc->pos_diag[i] < 0) erro = 2;
+            }
+
+            for (int i = 0; i < n && !erro; i++) {
+                for (int k = lu->row_ptr[i]; k < lu->row_ptr[i + 1]; k++) pos[lu->col_idx[k]] = k;
+
+                /* elimina as colunas c < i com as linhas c já fatoradas */
+                for (int k = lu->row_ptr[i]; k < pc->pos_diag[i]; k++) {
+                    int c = lu->col_idx[k];
+                    float lic = lu->values[k] / lu->values[pc->pos_diag[c]];
+                    lu->values[k] = lic;
+                    for (int kk = pc->pos_diag[c] + 1; kk < lu->row_ptr[c + 1]; kk++) {
+                        int j = lu->col_idx[kk];
+                        if (pos[j] >= 0) lu->values[pos[j]] -= lic * lu->values[kk];
+                    }
+                }
+                if (lu->values[pc->pos_diag[i]] == 0.0f) erro = 2;
+
+                for (int k = lu->row_ptr[i]; k < lu->row_ptr[i + 1]; k++) pos[lu->col_idx[k]] = -1;
+            }
+        }
+        free(pos);
+    }
+
+    if (erro) {
+        precond_destroy(pc);
+        return erro;
+    }
+    *p = pc;
+    return 0;
+}
+
+/**
+ * @brief Libera um pré-condicionador criado por `precond_init`.
+ *
+ * @param p Ponteiro para o pré-condicionador (pode ser NULL).
+ */
+void precond_destroy(Precondicionador *p) {
+    if (!p) return;
+
+    free(p->diag_inv);
+    csr_destroy(p->lu);
+    free(p->pos_diag);
+    free(p);
+}
+
+/**
+ * @brief Aplica o pré-condicionador: resolve M z = r.
+ *
+ * Com ILU(0), faz a substituição progressiva com L e a regressiva com U.
+ * `r` e `z` não podem ser o mesmo vetor.
+ *
+ * @param p Ponteiro constante para o pré-condicionador.
+ * @param r Vetor com n posições.
+ * @param z Vetor com n posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int precond_aplica(const Precondicionador *p, const float *r, float *z) {
+    if (!p || !r || !z) return 1;
+
+    int n = p->n;
+    if (p->tipo == PRECOND_NENHUM) {
+        memcpy(z, r, (size_t)n * sizeof(float));
+        return 0;
+    }
+
+    if (p->tipo == PRECOND_JACOBI) {
+        for (int i = 0; i < n; i++) z[i] = r[i] * p->diag_inv[i];
+        return 0;
+    }
+
+    const MatrixCSR *lu = p->lu;
+    for (int i = 0; i < n; i++) {
+        double s = r[i];
+        for (int k = lu->row_ptr[i]; k < p->pos_diag[i]; k++) s -= (double)lu->values[k] * z[lu->col_idx[k]];
+        z[i] = (float)s;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double s = z[i];
+        for (int k = p->pos_diag[i] + 1; k < lu->row_ptr[i + 1]; k++) s -= (double)lu->values[k] * z[lu->col_idx[k]];
+        z[i] = (float)(s / lu->values[p->pos_diag[i]]);
+    }
+    return 0;
+}
+
+/**
+ * @brief Aloca o espaço de trabalho dos solvers para sistemas n x n.
+ *
+ * O mesmo espaço serve para `solver_cg` e `solver_bicgstab` e pode ser
+ * reutilizado entre chamadas com a mesma dimensão.
+ *
+ * @param n Dimensão do sistema (> 0).
+ * @param max_iter Maior número de iterações que será pedido (> 0).
+ *
+ * @return Ponteiro para o espaço de trabalho ou NULL se os parâmetros forem
+ *         inválidos ou se falhar alguma alocação.
+ */
+SolverWork* solver_work_init(int n, int max_iter) {
+    if (n <= 0 || max_iter <= 0) return NULL;
+
+    SolverWork *w = (SolverWork*)calloc(1, sizeof(SolverWork));
+    if (!w) return NULL;
+
+    w->n = n;
+    w->max_iter = max_iter;
+    int erro = 0;
+    for (int t = 0; t < SOLVER_NVETORES; t++) {
+        w->v[t] = (float*)malloc((size_t)n * sizeof(float));
+        if (!w->v[t]) erro = 1;
+    }
+    w->ns_iter = (long long*)malloc((size_t)max_iter * sizeof(long long));
+    if (!w->ns_iter) erro = 1;
+
+    if (erro) {
+        solver_work_destroy(w);
+        return NULL;
+    }
+    return w;
+}
+
+/**
+ * @brief Libera um espaço de trabalho criado por `solver_work_init`.
+ *
+ * @param w Ponteiro para o espaço de trabalho (pode ser NULL).
+ */
+void solver_work_destroy(SolverWork *w) {
+    if (!w) return;
+
+    for (int t = 0; t < SOLVER_NVETORES; t++) free(w->v[t]);
+    free(w->ns_iter);
+    free(w);
+}
+
+static int parametros_validos(const MatrixCSR *a, const float *b, const float *x, const SolverOpcoes *op, const SolverWork *w) {
+    if (!a || !b || !x || !op || !w) return 0;
+    if (a->linhas != a->colunas || w->n != a->linhas) return 0;
+    if (op->max_iter < 0 || op->max_iter > w->max_iter) return 0;
+    if (op->precond && op->precond->n != a->linhas) return 0;
+    return 1;
+}
+
+/* Chamadas cronometradas, somadas em `res`. */
+static void spmv_t(const MatrixCSR *a, const float *x, float *y, SolverResultado *res) {
+    long long t0 = timer_ns();
+    csr_spmv(a, x, y);
+    res->ns_spmv += timer_ns() - t0;
+}
+
+static void precond_t(const SolverOpcoes *op, int n, const float *r, float *z, SolverResultado *res) {
+    long long t0 = timer_ns();
+    if (op->precond) precond_aplica(op->precond, r, z);
+    else memcpy(z, r, (size_t)n * sizeof(float));
+    res->ns_precond += timer_ns() - t0;
+}
+
+/* r = b - A x; retorna ||b|| (0 se b == 0, caso em que x = 0). */
+static double residuo_inicial(const MatrixCSR *a, const float *b, float *x, float *r, SolverResultado *res) {
+    int n = a->linhas;
+    double nb = norma(b, n);
+    if (nb == 0.0) {
+        memset(x, 0, (size_t)n * sizeof(float));
+        memset(r, 0, (size_t)n * sizeof(float));
+        return 0.0;
+    }
+    spmv_t(a, x, r, res);
+    for (int i = 0; i < n; i++) r[i] = b[i] - r[i];
+    return nb;
+}
+
+/* Registra o tempo da iteração e chama o callback; retorna != 0 para parar. */
+static int fim_iteracao(const SolverOpcoes *op, SolverWork *w, SolverResultado *res, int k, double rel, long long t_iter) {
+    w->ns_iter[k - 1] = timer_ns() - t_iter;
+    res->iteracoes = k;
+    res->residuo = rel;
+    return op->callback ? op->callback(k, rel, op->dados) : 0;
+}
+
+/**
+ * @brief Resolve A x = b pelo método dos gradientes conjugados pré-condicionado.
+ *
+ * A deve ser simétrica positiva definida (e o pré-condicionador também). `x`
+ * entra com a estimativa inicial e sai com a solução. Para quando o resíduo
+ * relativo ||b - A x|| / ||b|| for <= op->tol. O produto matriz-vetor é
+ * `csr_spmv` e os produtos internos são acumulados em double. Nenhuma memória
+ * é alocada: os vetores auxiliares vêm de `w`, e o tempo de cada iteração fica
+ * em w->ns_iter[0 .. res->iteracoes - 1].
+ *
+ * @param a Ponteiro constante para A (n x n).
+ * @param b Lado direito, com n posições.
+ * @param x Estimativa inicial e solução, com n posições.
+ * @param op Opções: máximo de iterações, tolerância, pré-condicionador
+ *           (NULL para nenhum) e callback (opcional).
+ * @param w Espaço de trabalho com w->n == n e w->max_iter >= op->max_iter.
+ * @param res Se não for NULL, recebe iterações, resíduo relativo final e tempos.
+ *
+ * @return 0 se convergiu.
+ * @return 1 se algum ponteiro for NULL ou se as dimensões forem incompatíveis.
+ * @return 2 em caso de colapso numérico (pᵀ A p == 0).
+ * @return 3 se não convergiu em op->max_iter iterações ou se o callback pediu parada.
+ */
+int solver_cg(const MatrixCSR *a, const float *b, float *x, const SolverOpcoes *op, SolverWork *w, SolverResultado *res) {
+    SolverResultado local;
+    if (!res) res = &local;
+    memset(res, 0, sizeof(SolverResultado));
+    if (!parametros_validos(a, b, x, op, w)) return 1;
+
+    long long t_ini = timer_ns();
+    int n = a->linhas;
+    float *r = w->v[0], *z = w->v[1], *p = w->v[2], *q = w->v[3];
+    int ret = 3;
+
+    double nb = residuo_inicial(a, b, x, r, res);
+    res->residuo = nb == 0.0 ? 0.0 : norma(r, n) / nb;
+    if (res->residuo <= op->tol) {
+        res->ns_total = timer_ns() - t_ini;
+        return 0;
+    }
+
+    precond_t(op, n, r, z, res);
+    memcpy(p, z, (size_t)n * sizeof(float));
+    double rz = dot(r, z, n);
+
+    for (int k = 1; k <= op->max_iter; k++) {
+        long long t_iter = timer_ns();
+
+        spmv_t(a, p, q, res);
+        double pq = dot(p, q, n);
+        if (pq == 0.0) {
+            ret = 2;
+            break;
+        }
+        float alfa = (float)(rz / pq);
+        for (int i = 0; i < n; i++) {
+            x[i] += alfa * p[i];
+            r[i] -= alfa * q[i];
+        }
+
+        double rel = norma(r, n) / nb;
+        int convergiu = rel <= op->tol;
+        if (!convergiu) {
+            precond_t(op, n, r, z, res);
+            double rz_novo = dot(r, z, n);
+            float beta = (float)(rz_novo / rz);
+            for (int i = 0; i < n; i++) p[i] = z[i] + beta * p[i];
+            rz = rz_novo;
+        }
+
+        if (fim_iteracao(op, w, res, k, rel, t_iter) && !convergiu) break;
+        if (convergiu) {
+            ret = 0;
+            break;
+        }
+        if (rz == 0.0) {
+            ret = 2;
+            break;
+        }
+    }
+
+    res->ns_total = timer_ns() - t_ini;
+    return ret;
+}
+
+/**
+ * @brief Resolve A x = b pelo BiCGSTAB com pré-condicionamento à direita.
+ *
+ * Serve para A não simétrica. Mesmas convenções de `solver_cg`: `x` entra com
+ * a estimativa inicial, o critério de parada é o resíduo relativo, os vetores
+ * auxiliares vêm de `w` (usa os SOLVER_NVETORES) e nada é alocado.
+ *
+ * @param a Ponteiro constante para A (n x n).
+ * @param b Lado direito, com n posições.
+ * @param x Estimativa inicial e solução, com n posições.
+ * @param op Opções (ver `solver_cg`).
+ * @param w Espaço de trabalho com w->n == n e w->max_iter >= op->max_iter.
+ * @param res Se não for NULL, recebe iterações, resíduo relativo final e tempos.
+ *
+ * @return 0 se convergiu.
+ * @return 1 se algum ponteiro for NULL ou se as dimensões forem incompatíveis.
+ * @return 2 em caso de colapso numérico (ρ, r̂ᵀv ou tᵀt nulos, ou ω == 0).
+ * @return 3 se não convergiu em op->max_iter iterações ou se o callback pediu parada.
+ */
+int solver_bicgstab(const MatrixCSR *a, const float *b, float *x, const SolverOpcoes *op, SolverWork *w, SolverResultado *res) {
+    SolverResultado local;
+    if (!res) res = &local;
+    memset(res, 0, sizeof(SolverResultado));
+    if (!parametros_validos(a, b, x, op, w)) return 1;
+
+    long long t_ini = timer_ns();
+    int n = a->linhas;
+    float *r = w->v[0], *r0 = w->v[1], *p = w->v[2], *v = w->v[3];
+    float *s = w->v[4], *t = w->v[5], *ph = w->v[6], *sh = w->v[7];
+    int ret = 3;
+
+    double nb = residuo_inicial(a, b, x, r, res);
+    res->residuo = nb == 0.0 ? 0.0 : norma(r, n) / nb;
+    if (res->residuo <= op->tol) {
+        res->ns_total = timer_ns() - t_ini;
+        return 0;
+    }
+
+    memcpy(r0, r, (size_t)n * sizeof(float));
+    double rho = 1.0, alfa = 1.0, omega = 1.0;
+
+    for (int k = 1; k <= op->max_iter; k++) {
+        long long t_iter = timer_ns();
+
+        double rho_novo = dot(r0, r, n);
+        if (rho_novo == 0.0) {
+            ret = 2;
+            break;
+        }
+        if (k == 1) {
+            memcpy(p, r, (size_t)n * sizeof(float));
+        } else {
+            float beta = (float)((rho_novo / rho) * (alfa / omega));
+            float om = (float)omega;
+            for (int i = 0; i < n; i++) p[i] = r[i] + beta * (p[i] - om * v[i]);
+        }
+        rho = rho_novo;
+
+        precond_t(op, n, p, ph, res);
+        spmv_t(a, ph, v, res);
+        double r0v = dot(r0, v, n);
+        if (r0v == 0.0) {
+            ret = 2;
+            break;
+        }
+        alfa = rho / r0v;
+
+        float af = (float)alfa;
+        for (int i = 0; i < n; i++) s[i] = r[i] - af * v[i];
+
+        double rel = norma(s, n) / nb;
+        if (rel <= op->tol) {
+            for (int i = 0; i < n; i++) x[i] += af * ph[i];
+            fim_iteracao(op, w, res, k, rel, t_iter);
+            ret = 0;
+            break;
+        }
+
+        precond_t(op, n, s, sh, res);
+        spmv_t(a, sh, t, res);
+        double tt = dot(t, t, n);
+        if (tt == 0.0) {
+            ret = 2;
+            break;
+        }
+        omega = dot(t, s, n) / tt;
+
+        float om = (float)omega;
+        for (int i = 0; i < n; i++) {
+            x[i] += af * ph[i] + om * sh[i];
+            r[i] = s[i] - om * t[i];
+        }
+
+        rel = norma(r, n) / nb;
+        int parar = fim_iteracao(op, w, res, k, rel, t_iter);
+        if (rel <= op->tol) {
+            ret = 0;
+            break;
+        }
+        if (omega == 0.0) {
+            ret = 2;
+            break;
+        }
+        if (parar) break;
+    }
+
+    res->ns_total = timer_ns() - t_ini;
+    return ret;
+}
@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <string.h>
+#include "spgemm.h"
+#include "create.h"
+#include "pool.h"
+
+static int cmp_int(const void *a, const void *b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Fase simbólica do produto A * B: calcula a estrutura e o plano de espalhamento.
+ *
+ * Percorre os produtos parciais uma vez, determina as colunas de cada linha do
+ * resultado e monta `*r` com essa estrutura (todos os nós reservados de uma vez,
+ * valores 0.0). Em `*plano` fica, para cada produto parcial, a posição do
+ * elemento do resultado que ele alimenta, além do espaço de trabalho da fase
+ * numérica. Depois disso, `matrix_multiply_numeric` recalcula os valores sem
+ * nenhuma alocação sempre que os valores de A e B mudarem.
+ *
+ * Memória do plano: um int por produto parcial e um double por elemento do resultado.
+ *
+ * @param a Ponteiro constante para A (m x p).
+ * @param b Ponteiro constante para B (p x q).
+ * @param plano Endereço de ponteiro que receberá o plano; liberar com `plano_produto_destroy`.
+ * @param r Endereço de ponteiro que receberá o resultado (m x q) com a estrutura do produto.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se a->colunas != b->linhas,
+ *         se o resultado tiver mais de INT_MAX elementos ou se falhar alguma alocação.
+ * @return 2 se `a` contiver uma coluna fora dos limites de `b`.
+ *
+ * @post Em sucesso, `*plano` e `*r` apontam para novos objetos; em erro, ambos permanecem NULL.
+ */
+int matrix_multiply_symbolic(const Matrix *a, const Matrix *b, PlanoProduto **plano, Matrix **r) {
+    if (!a || !b || !plano || !r) return 1;
+    *plano = NULL;
+    *r = NULL;
+    if (!a->mat || !b->mat || a->colunas != b->linhas) return 1;
+
+    int q = b->colunas;
+    int *tam_b = (int*)malloc((size_t)b->linhas * sizeof(int));
+    if (!tam_b) return 1;
+    for (int k = 0; k < b->linhas; k++) {
+        tam_b[k] = 0;
+        for (POINT pb = b->mat[k]; pb; pb = pb->prox) tam_b[k]++;
+    }
+
+    long long nprod = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        for (POINT pa = a->mat[i]; pa; pa = pa->prox) {
+            if (pa->coluna < 1 || pa->coluna > b->linhas) {
+                free(tam_b);
+                return 2;
+            }
+            nprod += tam_b[pa->coluna - 1];
+        }
+    }
+    free(tam_b);
+
+    PlanoProduto *pl = (PlanoProduto*)calloc(1, sizeof(PlanoProduto));
+    Matrix *res = init_matrix(a->linhas, q);
+    int *marca = (int*)malloc((size_t)q * sizeof(int));
+    int *tocadas = (int*)malloc((size_t)q * sizeof(int));
+    int *pos = (int*)malloc((size_t)q * sizeof(int));
+    int erro = !pl || !res || !marca || !tocadas || !pos;
+
+    if (!erro) {
+        pl->destino = (int*)malloc((nprod ? (size_t)nprod : 1) * sizeof(int));
+        if (!pl->destino) erro = 1;
+    }
+
+    long long t = 0;
+    long long nnz = 0;
+    if (!erro) {
+        for (int j = 0; j < q; j++) marca[j] = -1;
+    }
+
+    for (int i = 0; i < a->linhas && !erro; i++) {
+        long long t0 = t;
+        int ntoc = 0;
+
+        for (POINT pa = a->mat[i]; pa; pa = pa->prox) {
+            for (POINT pb = b->mat[pa->coluna - 1]; pb; pb = pb->prox) {
+                int j = pb->coluna - 1;
+                if (marca[j] != i) {
+                    marca[j] = i;
+                    tocadas[ntoc++] = j;
+                }
+                pl->destino[t++] = j;
+            }
+        }
+
+        qsort(tocadas, (size_t)ntoc, sizeof(int), cmp_int);
+        if (nnz + ntoc > 0x7fffffff || pool_reserve(&res->pool, ntoc)) {
+            erro = 1;
+            break;
+        }
+
+        POINT *cauda = &res->mat[i];
+        for (int u = 0; u < ntoc; u++) {
+            No *novo = pool_alloc(&res->pool);
+            novo->coluna = tocadas[u] + 1;
+            novo->valor = 0.0f;
+            novo->prox = NULL;
+            *cauda = novo;
+            cauda = &novo->prox;
+            pos[tocadas[u]] = (int)nnz + u;
+        }
+
+        for (long long p = t0; p < t; p++) pl->destino[p] = pos[pl->destino[p]];
+        nnz += ntoc;
+    }
+
+    if (!erro) {
+        pl->acc = (double*)malloc((nnz ? (size_t)nnz : 1) * sizeof(double));
+        if (!pl->acc) erro = 1;
+    }
+
+    free(marca);
+    free(tocadas);
+    free(pos);
+
+    if (erro) {
+        plano_produto_destroy(pl);
+        matrix_destroy(res);
+        return 1;
+    }
+
+    pl->linhas = a->linhas;
+    pl->colunas = q;
+    pl->nnz = (int)nnz;
+    pl->nprod = nprod;
+
+    *plano = pl;
+    *r = res;
+    return 0;
+}
+
+/**
+ * @brief Fase numérica: recalcula os valores de `r = A * B` usando o plano, sem alocar.
+ *
+ * A e B devem ter exatamente a estrutura que tinham na fase simbólica (apenas
+ * os valores podem mudar), e `r` deve ser a matriz criada por ela, sem
+ * alterações de estrutura. Os produtos parciais são somados em double
+ * diretamente na posição indicada pelo plano e, ao final, os valores são
+ * gravados nos nós de `r` em uma passada. Diferente de `matrix_multiply`, os
+ * elementos que resultarem em 0.0 continuam armazenados (com valor 0.0), para
+ * que a estrutura não mude entre chamadas.
+ *
+ * @param plano Plano criado por `matrix_multiply_symbolic`.
+ * @param a Ponteiro constante para A.
+ * @param b Ponteiro constante para B.
+ * @param r Resultado criado por `matrix_multiply_symbolic`.
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL ou se as dimensões não forem as do plano.
+ * @return 2 se o número de produtos parciais de A * B ou de elementos de `r`
+ *         não for o do plano (`r` pode ter sido parcialmente atualizada).
+ *         Mudanças de estrutura que preservem essas contagens não são detectadas.
+ */
+int matrix_multiply_numeric(PlanoProduto *plano, const Matrix *a, const Matrix *b, Matrix *r) {
+    if (!plano || !a || !b || !r) return 1;
+    if (!a->mat || !b->mat || !r->mat) return 1;
+    if (a->linhas != plano->linhas || b->colunas != plano->colunas || a->colunas != b->linhas) return 1;
+    if (r->linhas != plano->linhas || r->colunas != plano->colunas) return 1;
+
+    double *acc = plano->acc;
+    const int *destino = plano->destino;
+    memset(acc, 0, (size_t)plano->nnz * sizeof(double));
+
+    long long t = 0;
+    for (int i = 0; i < a->linhas; i++) {
+        for (POINT pa = a->mat[i]; pa; pa = pa->prox) {
+            if (pa->coluna < 1 || pa->coluna > b->linhas) return 2;
+            double va = pa->valor;
+            for (POINT pb = b->mat[pa->coluna - 1]; pb; pb = pb->prox) {
+                if (t == plano->nprod) return 2;
+                acc[destino[t++]] += va * pb->valor;
+            }
+        }
+    }
+    if (t != plano->nprod) return 2;
+
+    int w = 0;
+    for (int i = 0; i < r->linhas; i++) {
+        for (POINT p = r->mat[i]; p; p = p->prox) {
+            if (w == plano->nnz) return 2;
+            p->valor = (float)acc[w++];
+        }
+    }
+    return w == plano->nnz ? 0 : 2;
+}
+
+/**
+ * @brief Libera um plano criado por `matrix_multiply_symbolic`.
+ *
+ * @param plano Ponteiro para o plano (pode ser NULL).
+ */
+void plano_produto_destroy(PlanoProduto *plano) {
+    if (!plano) return;
+
+    free(plano->destino);
+    free(plano->acc);
+    free(plano);
+}
@@ -0,0 +1,255 @@
+#include <string.h>
+#include "spmm.h"
+#include "simd.h"
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * Colunas de B/C tratadas por passada. As colunas são processadas em painéis
+ * de PAINEL (painéis por fora, linhas de A por dentro), de modo que só a
+ * fatia de B do painel atual precisa ficar na cache; dentro do painel, a
+ * linha de C fica inteira em registradores (4 zmm ou 8 ymm).
+ */
+#define PAINEL 64
+
+static void spmm_escalar(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int ini, int fim) {
+    for (int j0 = 0; j0 < k; j0 += PAINEL) {
+        int w = k - j0 < PAINEL ? k - j0 : PAINEL;
+
+        for (int i = ini; i < fim; i++) {
+            float acc[PAINEL] = {0.0f};
+            for (int p = a->row_ptr[i]; p < a->row_ptr[i + 1]; p++) {
+                float v = a->values[p];
+                const float *bl = b + (size_t)a->col_idx[p] * ldb + j0;
+                for (int j = 0; j < w; j++) acc[j] += v * bl[j];
+            }
+            memcpy(c + (size_t)i * ldc + j0, acc, (size_t)w * sizeof(float));
+        }
+    }
+}
+
+#if SIMD_X86
+/* Painéis de 64 colunas com 8 acumuladores; o resto vai numa passada só, com máscaras. */
+__attribute__((target("avx2,fma")))
+static void spmm_avx2(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int ini, int fim) {
+    int j0 = 0;
+    for (; j0 + PAINEL <= k; j0 += PAINEL) {
+        for (int i = ini; i < fim; i++) {
+            __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps(), c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+            __m256 c4 = _mm256_setzero_ps(), c5 = _mm256_setzero_ps(), c6 = _mm256_setzero_ps(), c7 = _mm256_setzero_ps();
+
+            for (int p = a->row_ptr[i]; p < a->row_ptr[i + 1]; p++) {
+                __m256 v = _mm256_set1_ps(a->values[p]);
+                const float *bl = b + (size_t)a->col_idx[p] * ldb + j0;
+                c0 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl), c0);
+                c1 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl + 8), c1);
+                c2 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl + 16), c2);
+                c3 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl + 24), c3);
+                c4 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl + 32), c4);
+                c5 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl + 40), c5);
+                c6 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl + 48), c6);
+                c7 = _mm256_fmadd_ps(v, _mm256_loadu_ps(bl + 56), c7);
+            }
+
+            float *cl = c + (size_t)i * ldc + j0;
+            _mm256_storeu_ps(cl, c0);
+            _mm256_storeu_ps(cl + 8, c1);
+            _mm256_storeu_ps(cl + 16, c2);
+            _mm256_storeu_ps(cl + 24, c3);
+            _mm256_storeu_ps(cl + 32, c4);
+            _mm256_storeu_ps(cl + 40, c5);
+            _mm256_storeu_ps(cl + 48, c6);
+            _mm256_storeu_ps(cl + 56, c7);
+        }
+    }
+
+    /* resto (< 64 colunas) numa única passada por A, com até 8 acumuladores mascarados */
+    int r = k - j0;
+    if (r > 0) {
+        __m256i ind = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i m[8];
+        for (int t = 0; t < 8; t++) m[t] = _mm256_cmpgt_epi32(_mm256_set1_epi32(r - 8 * t), ind);
+
+        for (int i = ini; i < fim; i++) {
+            __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps(), c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+            __m256 c4 = _mm256_setzero_ps(), c5 = _mm256_setzero_ps(), c6 = _mm256_setzero_ps(), c7 = _mm256_setzero_ps();
+
+            for (int p = a->row_ptr[i]; p < a->row_ptr[i + 1]; p++) {
+                __m256 v = _mm256_set1_ps(a->values[p]);
+                const float *bl = b + (size_t)a->col_idx[p] * ldb + j0;
+                c0 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl, m[0]), c0);
+                if (r > 8) c1 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl + 8, m[1]), c1);
+                if (r > 16) c2 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl + 16, m[2]), c2);
+                if (r > 24) c3 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl + 24, m[3]), c3);
+                if (r > 32) c4 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl + 32, m[4]), c4);
+                if (r > 40) c5 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl + 40, m[5]), c5);
+                if (r > 48) c6 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl + 48, m[6]), c6);
+                if (r > 56) c7 = _mm256_fmadd_ps(v, _mm256_maskload_ps(bl + 56, m[7]), c7);
+            }
+
+            /* máscaras zeradas não gravam nada */
+            float *cl = c + (size_t)i * ldc + j0;
+            _mm256_maskstore_ps(cl, m[0], c0);
+            _mm256_maskstore_ps(cl + 8, m[1], c1);
+            _mm256_maskstore_ps(cl + 16, m[2], c2);
+            _mm256_maskstore_ps(cl + 24, m[3], c3);
+            _mm256_maskstore_ps(cl + 32, m[4], c4);
+            _mm256_maskstore_ps(cl + 40, m[5], c5);
+            _mm256_maskstore_ps(cl + 48, m[6], c6);
+            _mm256_maskstore_ps(cl + 56, m[7], c7);
+        }
+    }
+}
+
+/* Painéis de 64 colunas com 4 acumuladores; o resto vai numa passada só, com máscaras. */
+__attribute__((target("avx512f")))
+static void spmm_avx512(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int ini, int fim) {
+    int j0 = 0;
+    for (; j0 + PAINEL <= k; j0 += PAINEL) {
+        for (int i = ini; i < fim; i++) {
+            __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps(), c2 = _mm512_setzero_ps(), c3 = _mm512_setzero_ps();
+
+            for (int p = a->row_ptr[i]; p < a->row_ptr[i + 1]; p++) {
+                __m512 v = _mm512_set1_ps(a->values[p]);
+                const float *bl = b + (size_t)a->col_idx[p] * ldb + j0;
+                c0 = _mm512_fmadd_ps(v, _mm512_loadu_ps(bl), c0);
+                c1 = _mm512_fmadd_ps(v, _mm512_loadu_ps(bl + 16), c1);
+                c2 = _mm512_fmadd_ps(v, _mm512_loadu_ps(bl + 32), c2);
+                c3 = _mm512_fmadd_ps(v, _mm512_loadu_ps(bl + 48), c3);
+            }
+
+            float *cl = c + (size_t)i * ldc + j0;
+            _mm512_storeu_ps(cl, c0);
+            _mm512_storeu_ps(cl + 16, c1);
+            _mm512_storeu_ps(cl + 32, c2);
+            _mm512_storeu_ps(cl + 48, c3);
+        }
+    }
+
+    /* resto (< 64 colunas) numa única passada por A, com até 4 acumuladores mascarados */
+    int r = k - j0;
+    if (r > 0) {
+        __mmask16 m[4];
+        for (int t = 0; t < 4; t++) {
+            int w = r - 16 * t;
+            m[t] = (__mmask16)(w >= 16 ? 0xffffu : w > 0 ? (1u << w) - 1 : 0u);
+        }
+
+        for (int i = ini; i < fim; i++) {
+            __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps(), c2 = _mm512_setzero_ps(), c3 = _mm512_setzero_ps();
+
+            for (int p = a->row_ptr[i]; p < a->row_ptr[i + 1]; p++) {
+                __m512 v = _mm512_set1_ps(a->values[p]);
+                const float *bl = b + (size_t)a->col_idx[p] * ldb + j0;
+                c0 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(m[0], bl), c0);
+                if (r > 16) c1 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(m[1], bl + 16), c1);
+                if (r > 32) c2 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(m[2], bl + 32), c2);
+                if (r > 48) c3 = _mm512_fmadd_ps(v, _mm512_maskz_loadu_ps(m[3], bl + 48), c3);
+            }
+
+            float *cl = c + (size_t)i * ldc + j0;
+            _mm512_mask_storeu_ps(cl, m[0], c0);
+            _mm512_mask_storeu_ps(cl + 16, m[1], c1);
+            _mm512_mask_storeu_ps(cl + 32, m[2], c2);
+            _mm512_mask_storeu_ps(cl + 48, m[3], c3);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Escolhe o kernel por faixa de linhas (AVX-512, AVX2 ou escalar) conforme `simd_nivel()` e `k`.
+ *
+ * Com k <= 8 colunas, o kernel AVX2 basta e evita a meia largura ociosa do
+ * AVX-512. Quem divide o trabalho entre threads resolve o kernel uma vez, na
+ * thread chamadora, e o repassa às faixas.
+ */
+KernelSpmm csr_spmm_kernel(int k) {
+#if SIMD_X86
+    switch (simd_nivel()) {
+        case SIMD_AVX512:
+            return k <= 8 ? spmm_avx2 : spmm_avx512;
+        case SIMD_AVX2:
+            return spmm_avx2;
+        default:
+            break;
+    }
+#else
+    (void)k;
+#endif
+    return spmm_escalar;
+}
+
+/**
+ * @brief Calcula as linhas [ini, fim) de C = A * B no formato CSR.
+ *
+ * Usa o kernel de `csr_spmm_kernel(k)`. Não valida os parâmetros (ver `csr_spmm`).
+ */
+void csr_spmm_faixa(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc, int ini, int fim) {
+    csr_spmm_kernel(k)(a, b, k, ldb, c, ldc, ini, fim);
+}
+
+/**
+ * @brief Produto matriz esparsa por matriz densa C = A * B sobre as listas encadeadas.
+ *
+ * Para cada painel de colunas de B, cada linha de C é acumulada em um vetor
+ * local com um laço contínuo por elemento de A (vetorizável pelo compilador).
+ *
+ * @param a Ponteiro constante para a matriz esparsa (linhas x colunas).
+ * @param b Matriz densa (a->colunas x k), por linha, com passo `ldb`.
+ * @param k Número de colunas de B e C (> 0).
+ * @param ldb Passo entre linhas de B (>= k).
+ * @param c Matriz densa (a->linhas x k), por linha, com passo `ldc` (sobrescrita).
+ * @param ldc Passo entre linhas de C (>= k).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se k <= 0 ou se ldb/ldc < k.
+ */
+int matrix_spmm(const Matrix *a, const float *b, int k, int ldb, float *c, int ldc) {
+    if (!a || !a->mat || !b || !c) return 1;
+    if (k <= 0 || ldb < k || ldc < k) return 1;
+
+    for (int j0 = 0; j0 < k; j0 += PAINEL) {
+        int w = k - j0 < PAINEL ? k - j0 : PAINEL;
+
+        for (int i = 0; i < a->linhas; i++) {
+            float acc[PAINEL] = {0.0f};
+            for (POINT p = a->mat[i]; p; p = p->prox) {
+                float v = p->valor;
+                const float *bl = b + (size_t)(p->coluna - 1) * ldb + j0;
+                for (int j = 0; j < w; j++) acc[j] += v * bl[j];
+            }
+            memcpy(c + (size_t)i * ldc + j0, acc, (size_t)w * sizeof(float));
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Produto matriz esparsa por matriz densa C = A * B no formato CSR.
+ *
+ * As colunas de B são processadas em painéis de 64; para cada linha de A, a
+ * linha de C do painel fica em registradores e recebe, por elemento a(i, p),
+ * o produto com a linha p de B (broadcast + FMA). Escolhe em tempo de
+ * execução o kernel AVX-512, AVX2 ou escalar, conforme `simd_nivel()`. Com
+ * FMA, o arredondamento pode diferir da versão escalar no último bit.
+ *
+ * @param a Ponteiro constante para a matriz CSR (linhas x colunas).
+ * @param b Matriz densa (a->colunas x k), por linha, com passo `ldb`.
+ * @param k Número de colunas de B e C (> 0).
+ * @param ldb Passo entre linhas de B (>= k).
+ * @param c Matriz densa (a->linhas x k), por linha, com passo `ldc` (sobrescrita).
+ * @param ldc Passo entre linhas de C (>= k).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL, se k <= 0 ou se ldb/ldc < k.
+ */
+int csr_spmm(const MatrixCSR *a, const float *b, int k, int ldb, float *c, int ldc) {
+    if (!a || !b || !c) return 1;
+    if (k <= 0 || ldb < k || ldc < k) return 1;
+
+    csr_spmm_faixa(a, b, k, ldb, c, ldc, 0, a->linhas);
+    return 0;
+}
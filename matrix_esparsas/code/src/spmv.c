@@ -0,0 +1,231 @@
+#include <string.h>
+#include "spmv.h"
+#include "simd.h"
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+static inline float linha_escalar(const MatrixCSR *a, const float *x, int i) {
+    float soma = 0.0f;
+    for (int k = a->row_ptr[i]; k < a->row_ptr[i + 1]; k++) {
+        soma += a->values[k] * x[a->col_idx[k]];
+    }
+    return soma;
+}
+
+static void spmv_escalar(const MatrixCSR *a, const float *x, float *y, int ini, int fim) {
+    for (int i = ini; i < fim; i++) y[i] = linha_escalar(a, x, i);
+}
+
+static void spmv_t_escalar(const MatrixCSR *a, const float *x, float *y) {
+    for (int i = 0; i < a->linhas; i++) {
+        float xi = x[i];
+        if (xi == 0.0f) continue;
+        for (int k = a->row_ptr[i]; k < a->row_ptr[i + 1]; k++) {
+            y[a->col_idx[k]] += a->values[k] * xi;
+        }
+    }
+}
+
+#if SIMD_X86
+/*
+ * 8 elementos por vez: carrega colunas e valores, busca x[col] com gather e
+ * acumula com FMA. Linhas com menos de 8 elementos não pagam a redução
+ * horizontal e vão pelo laço escalar.
+ */
+__attribute__((target("avx2,fma")))
+static void spmv_avx2(const MatrixCSR *a, const float *x, float *y, int ini, int fim) {
+    for (int i = ini; i < fim; i++) {
+        int k = a->row_ptr[i];
+        int k_fim = a->row_ptr[i + 1];
+        if (k_fim - k < 8) {
+            y[i] = linha_escalar(a, x, i);
+            continue;
+        }
+        __m256 acc = _mm256_setzero_ps();
+
+        for (; k + 8 <= k_fim; k += 8) {
+            __m256i idx = _mm256_loadu_si256((const __m256i*)(a->col_idx + k));
+            __m256 v = _mm256_loadu_ps(a->values + k);
+            __m256 xv = _mm256_i32gather_ps(x, idx, 4);
+            acc = _mm256_fmadd_ps(v, xv, acc);
+        }
+
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        s = _mm_hadd_ps(s, s);
+        s = _mm_hadd_ps(s, s);
+        float soma = _mm_cvtss_f32(s);
+
+        for (; k < k_fim; k++) soma += a->values[k] * x[a->col_idx[k]];
+        y[i] = soma;
+    }
+}
+
+/*
+ * 16 elementos por vez; o restante da linha usa máscara em vez de laço escalar.
+ * Linhas com menos de 16 elementos vão pelo laço escalar: nelas o gather
+ * mascarado e a redução custam mais do que o próprio produto.
+ */
+__attribute__((target("avx512f")))
+static void spmv_avx512(const MatrixCSR *a, const float *x, float *y, int ini, int fim) {
+    for (int i = ini; i < fim; i++) {
+        int k = a->row_ptr[i];
+        int k_fim = a->row_ptr[i + 1];
+        if (k_fim - k < 16) {
+            y[i] = linha_escalar(a, x, i);
+            continue;
+        }
+        __m512 acc = _mm512_setzero_ps();
+
+        for (; k + 16 <= k_fim; k += 16) {
+            __m512i idx = _mm512_loadu_si512((const void*)(a->col_idx + k));
+            __m512 v = _mm512_loadu_ps(a->values + k);
+            __m512 xv = _mm512_i32gather_ps(idx, x, 4);
+            acc = _mm512_fmadd_ps(v, xv, acc);
+        }
+        if (k < k_fim) {
+            __mmask16 m = (__mmask16)((1u << (k_fim - k)) - 1);
+            __m512i idx = _mm512_maskz_loadu_epi32(m, a->col_idx + k);
+            __m512 v = _mm512_maskz_loadu_ps(m, a->values + k);
+            __m512 xv = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), m, idx, x, 4);
+            acc = _mm512_fmadd_ps(v, xv, acc);
+        }
+
+        y[i] = _mm512_reduce_add_ps(acc);
+    }
+}
+
+/*
+ * y[col] += a(i, col) * x[i] com gather/scatter de 16 posições. As colunas de
+ * uma mesma linha são distintas, então o scatter não tem conflitos.
+ */
+__attribute__((target("avx512f")))
+static void spmv_t_avx512(const MatrixCSR *a, const float *x, float *y) {
+    for (int i = 0; i < a->linhas; i++) {
+        float xi = x[i];
+        if (xi == 0.0f) continue;
+
+        __m512 xv = _mm512_set1_ps(xi);
+        int k = a->row_ptr[i];
+        int k_fim = a->row_ptr[i + 1];
+
+        for (; k + 16 <= k_fim; k += 16) {
+            __m512i idx = _mm512_loadu_si512((const void*)(a->col_idx + k));
+            __m512 v = _mm512_loadu_ps(a->values + k);
+            __m512 yv = _mm512_i32gather_ps(idx, y, 4);
+            _mm512_i32scatter_ps(y, idx, _mm512_fmadd_ps(v, xv, yv), 4);
+        }
+        for (; k < k_fim; k++) y[a->col_idx[k]] += a->values[k] * xi;
+    }
+}
+#endif
+
+/**
+ * @brief Produto matriz-vetor y = A * x sobre as listas encadeadas.
+ *
+ * @param a Ponteiro constante para a matriz (linhas x colunas).
+ * @param x Vetor denso com a->colunas posições.
+ * @param y Vetor denso com a->linhas posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int matrix_spmv(const Matrix *a, const float *x, float *y) {
+    if (!a || !a->mat || !x || !y) return 1;
+
+    for (int i = 0; i < a->linhas; i++) {
+        float soma = 0.0f;
+        for (POINT p = a->mat[i]; p; p = p->prox) soma += p->valor * x[p->coluna - 1];
+        y[i] = soma;
+    }
+    return 0;
+}
+
+/**
+ * @brief Produto com a transposta y = Aᵀ * x sobre as listas encadeadas.
+ *
+ * Percorre A por linhas e espalha a->(i, j) * x[i] em y[j], sem montar a transposta.
+ *
+ * @param a Ponteiro constante para a matriz (linhas x colunas).
+ * @param x Vetor denso com a->linhas posições.
+ * @param y Vetor denso com a->colunas posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int matrix_spmv_t(const Matrix *a, const float *x, float *y) {
+    if (!a || !a->mat || !x || !y) return 1;
+
+    memset(y, 0, (size_t)a->colunas * sizeof(float));
+    for (int i = 0; i < a->linhas; i++) {
+        float xi = x[i];
+        if (xi == 0.0f) continue;
+        for (POINT p = a->mat[i]; p; p = p->prox) y[p->coluna - 1] += p->valor * xi;
+    }
+    return 0;
+}
+
+/**
+ * @brief Produto matriz-vetor y = A * x no formato CSR.
+ *
+ * Escolhe em tempo de execução o kernel AVX-512, AVX2 (gather + FMA) ou escalar,
+ * conforme `simd_nivel()` e o número médio de elementos por linha: um kernel
+ * vetorial só é usado se as linhas tiverem, em média, pelo menos a largura do
+ * vetor (16 ou 8); com linhas mais curtas, o escalar é mais rápido. A ordem das
+ * somas dos kernels vetoriais difere da versão escalar, então os resultados
+ * podem diferir no último bit.
+ *
+ * @param a Ponteiro constante para a matriz CSR (linhas x colunas).
+ * @param x Vetor denso com a->colunas posições.
+ * @param y Vetor denso com a->linhas posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int csr_spmv(const MatrixCSR *a, const float *x, float *y) {
+    if (!a || !x || !y) return 1;
+
+#if SIMD_X86
+    SimdNivel nivel = simd_nivel();
+    long long nnz = a->row_ptr[a->linhas];
+
+    if (nivel == SIMD_AVX512 && nnz >= 16LL * a->linhas) {
+        spmv_avx512(a, x, y, 0, a->linhas);
+        return 0;
+    }
+    if (nivel >= SIMD_AVX2 && nnz >= 8LL * a->linhas) {
+        spmv_avx2(a, x, y, 0, a->linhas);
+        return 0;
+    }
+#endif
+    spmv_escalar(a, x, y, 0, a->linhas);
+    return 0;
+}
+
+/**
+ * @brief Produto com a transposta y = Aᵀ * x no formato CSR, sem montar a transposta.
+ *
+ * Usa gather/scatter AVX-512 quando disponível; AVX2 não tem scatter, então
+ * nesse caso usa o kernel escalar.
+ *
+ * @param a Ponteiro constante para a matriz CSR (linhas x colunas).
+ * @param x Vetor denso com a->linhas posições.
+ * @param y Vetor denso com a->colunas posições (sobrescrito).
+ *
+ * @return 0 em caso de sucesso.
+ * @return 1 se algum ponteiro for NULL.
+ */
+int csr_spmv_t(const MatrixCSR *a, const float *x, float *y) {
+    if (!a || !x || !y) return 1;
+
+    memset(y, 0, (size_t)a->colunas * sizeof(float));
+#if SIMD_X86
+    if (simd_nivel() == SIMD_AVX512) {
+        spmv_t_avx512(a, x, y);
+        return 0;
+    }
+#endif
+    spmv_t_escalar(a, x, y);
+    return 0;
+}
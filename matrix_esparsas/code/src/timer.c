@@ -0,0 +1,15 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <time.h>
+#include "timer.h"
+
+/**
+ * @brief Retorna o instante atual de um relógio monotônico, em nanossegundos.
+ *
+ * Só faz sentido como diferença entre duas chamadas.
+ */
+long long timer_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
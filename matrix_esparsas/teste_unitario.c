@@ -1,8 +1,32 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
-#include "dataclass.h"
+#include "create.h"
+#include "manipulate.h"
+#include "math.h"
+#include "csr.h"
+#include "parallel.h"
+#include "coo.h"
+#include "mtx.h"
+#include "binary.h"
+#include "spmv.h"
+#include "spmm.h"
+#include "simd.h"
+#include "generators.h"
+#include "csr_tipado.h"
+#include "indice.h"
+#include "batch.h"
+#include "fused.h"
+#include "spgemm.h"
+#include "bsr.h"
+#include "solver.h"
+#include "reorder.h"
+#include "instrument.h"
+#include "hibrida.h"
+#include "elementwise.h"
+#include "semiring.h"
 
 
 
@@ -17,7 +41,137 @@
 static int assert_elem(const Matrix *m, int i, int j, float esperado) {
     float v = -1.0f;
     if (matrix_getelem(m, i, j, &v) != 0) return 1;
-    return 0;
+    return v == esperado ? 0 : 1;
+}
+
+static int assert_csr_elem(const MatrixCSR *c, int i, int j, float esperado) {
+    float v = -1.0f;
+    if (csr_getelem(c, i, j, &v) != 0) return 1;
+    return v == esperado ? 0 : 1;
+}
+
+/* Preenche `m` com ~densidade% de elementos pseudoaleatórios (reprodutível). */
+static void fill_random(Matrix *m, unsigned semente, int densidade) {
+    for (int i = 1; i <= m->linhas; i++) {
+        for (int j = 1; j <= m->colunas; j++) {
+            semente = semente * 1103515245u + 12345u;
+            if ((int)((semente >> 16) % 100) < densidade) {
+                matrix_setelem(m, i, j, (float)((int)((semente >> 8) % 19) - 9));
+            }
+        }
+    }
+}
+
+/* Interrompe o solver depois de `*dados` iterações. */
+static int para_depois_de(int iteracao, double residuo, void *dados) {
+    (void)residuo;
+    return iteracao >= *(int*)dados;
+}
+
+/* Verifica se todas as n posições de x estão a até `tol` de 1. */
+static int perto_de_um(const float *x, int n, float tol) {
+    for (int i = 0; i < n; i++) {
+        float d = x[i] - 1.0f;
+        if (d < -tol || d > tol) return 0;
+    }
+    return 1;
+}
+
+/* Compara elemento a elemento (ignora zeros armazenados explicitamente). */
+static int same_values(const Matrix *a, const Matrix *b) {
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 0;
+    for (int i = 1; i <= a->linhas; i++) {
+        for (int j = 1; j <= a->colunas; j++) {
+            float va = 0.0f, vb = 0.0f;
+            matrix_getelem(a, i, j, &va);
+            matrix_getelem(b, i, j, &vb);
+            if (va != vb) return 0;
+        }
+    }
+    return 1;
+}
+
+/* Função por elemento: mantém o valor se for maior que *limite, senão 0. */
+static float relu(float valor, int i, int j, void *dados) {
+    (void)i;
+    (void)j;
+    return valor > *(float*)dados ? valor : 0.0f;
+}
+
+static int same_matrix(const Matrix *a, const Matrix *b) {
+    if (a->linhas != b->linhas || a->colunas != b->colunas) return 0;
+    for (int i = 0; i < a->linhas; i++) {
+        POINT pa = a->mat[i], pb = b->mat[i];
+        while (pa && pb) {
+            if (pa->coluna != pb->coluna || pa->valor != pb->valor) return 0;
+            pa = pa->prox;
+            pb = pb->prox;
+        }
+        if (pa || pb) return 0;
+    }
+    return 1;
+}
+
+/* Semianel definido pelo usuário (max, min): caminho de maior gargalo. */
+#define SR_SUF max_min
+#define SR_ACUM float
+#define SR_ZERO (-__builtin_inff())
+#define SR_SOMA(x, y) ((x) > (y) ? (x) : (y))
+#define SR_PRODUTO(x, y) ((x) < (y) ? (x) : (y))
+#include "semiring_modelo.h"
+#undef SR_SUF
+#undef SR_ACUM
+#undef SR_ZERO
+#undef SR_SOMA
+#undef SR_PRODUTO
+SEMIRING_PROTOTIPOS(max_min)
+
+enum { SR_PLUS_TIMES, SR_MIN_PLUS, SR_MAX_TIMES, SR_LOR_LAND, SR_MAX_MIN };
+
+/*
+ * Confere c = a ⊕.⊗ b (com máscara opcional) contra o cálculo direto pela
+ * definição, sobre as matrizes em listas: mesma estrutura e mesmos valores.
+ */
+static int confere_semianel(int sr, const Matrix *a, const Matrix *b, const Matrix *mascara, int complemento, const MatrixCSR *c) {
+    int nnz = 0;
+    for (int i = 1; i <= a->linhas; i++) {
+        for (int j = 1; j <= b->colunas; j++) {
+            if (mascara) {
+                float vm = 0.0f;
+                matrix_getelem(mascara, i, j, &vm);
+                if ((vm != 0.0f) == (complemento != 0)) continue;
+            }
+
+            int tocado = 0;
+            double esperado = 0.0;
+            for (int k = 1; k <= a->colunas; k++) {
+                float va = 0.0f, vb = 0.0f;
+                matrix_getelem(a, i, k, &va);
+                matrix_getelem(b, k, j, &vb);
+                if (va == 0.0f || vb == 0.0f) continue;
+
+                double p;
+                switch (sr) {
+                    case SR_MIN_PLUS: p = (float)(va + vb); break;
+                    case SR_LOR_LAND: p = 1.0; break;
+                    case SR_MAX_MIN: p = va < vb ? va : vb; break;
+                    default: p = (double)va * vb; break;
+                }
+                if (!tocado) esperado = p;
+                else if (sr == SR_MIN_PLUS) esperado = p < esperado ? p : esperado;
+                else if (sr == SR_MAX_TIMES || sr == SR_MAX_MIN) esperado = p > esperado ? p : esperado;
+                else if (sr == SR_PLUS_TIMES) esperado += p;
+                tocado = 1;
+            }
+            if (!tocado || (sr == SR_PLUS_TIMES && (float)esperado == 0.0f)) continue;
+
+            /* os elementos de c aparecem na mesma ordem (linha, coluna) do laço */
+            if (nnz < c->row_ptr[i - 1] || nnz >= c->row_ptr[i]) return 0;
+            if (c->col_idx[nnz] != j - 1 || c->values[nnz] != (float)esperado) return 0;
+            nnz++;
+        }
+    }
+    return nnz == c->nnz;
 }
 
 int main(void) {
@@ -55,6 +209,56 @@ int main(void) {
     matrix_destroy(C);
     C = NULL;
 
+    /* ---------- TESTE: soma no lugar ---------- */
+    {
+        Matrix *X = init_matrix(40, 60), *Y = init_matrix(40, 60), *E = init_matrix(40, 60);
+        Matrix *Z = NULL, *S = NULL, *D = NULL;
+        ASSERT(X && Y && E, "Falha ao criar X/Y");
+        fill_random(X, 61u, 15);
+        fill_random(Y, 62u, 15);
+        matrix_setelem(X, 3, 5, 2.0f);
+        matrix_setelem(Y, 3, 5, -2.0f);
+
+        ASSERT(matrix_add(X, Y, &S) == 0, "Falha em matrix_add");
+        for (int ix = 0; ix < 2; ix++) {
+            ASSERT(matrix_add(X, E, &Z) == 0, "Falha ao copiar X");
+            if (ix) ASSERT(matrix_index_enable(Z) == 0, "Falha ao ligar indice de Z");
+
+            ASSERT(matrix_add_inplace(Z, Y) == 0 && same_matrix(Z, S), "matrix_add_inplace difere de matrix_add");
+            ASSERT(assert_elem(Z, 3, 5, 0.0f) == 0, "Cancelamento deveria remover Z(3,5)");
+            ASSERT(matrix_axpy(Z, -1.0f, Y) == 0 && same_values(Z, X), "matrix_axpy(-1) nao desfez a soma");
+            if (ix) ASSERT(Z->indice && assert_elem(Z, 3, 5, 2.0f) == 0, "Indice de Z nao foi mantido");
+            matrix_destroy(Z);
+        }
+
+        /* acumulação repetida: depois da primeira soma, nenhum nó novo sai de slabs novos */
+        ASSERT(matrix_add(X, E, &Z) == 0, "Falha ao copiar X");
+        ASSERT(matrix_axpy(Z, 0.5f, Y) == 0, "Falha em matrix_axpy");
+        int nslabs = Z->pool.nslabs;
+        long long vivos = Z->pool.alocados - Z->pool.liberados;
+        for (int k = 0; k < 50; k++) {
+            ASSERT(matrix_axpy(Z, -0.5f, Y) == 0 && matrix_axpy(Z, 0.5f, Y) == 0, "Falha na acumulacao");
+        }
+        ASSERT(Z->pool.nslabs == nslabs, "Acumulacao alocou slabs novos");
+        ASSERT(Z->pool.alocados - Z->pool.liberados == vivos, "Acumulacao vazou nos");
+
+        ASSERT(matrix_axpy(Z, 0.0f, Y) == 0 && Z->pool.alocados - Z->pool.liberados == vivos, "alfa 0 deveria ser no-op");
+        matrix_destroy(S);
+        ASSERT(matrix_add(Z, E, &S) == 0 && matrix_add(S, S, &D) == 0, "Falha ao copiar Z");
+        ASSERT(matrix_axpy(Z, 1.0f, Z) == 0 && same_matrix(Z, D), "A += A difere de matrix_add");
+        ASSERT(matrix_axpy(Z, -1.0f, Z) == 0, "Falha em A -= A");
+        for (int i = 0; i < 40; i++) ASSERT(!Z->mat[i], "A -= A deveria esvaziar");
+        ASSERT(matrix_add_inplace(Z, D) == 0 && same_matrix(Z, D), "Soma em matriz vazia difere");
+        ASSERT(matrix_add_inplace(Z, NULL) == 1 && matrix_add_inplace(Z, A) == 1, "Operandos invalidos deveriam falhar");
+
+        matrix_destroy(D);
+        matrix_destroy(Z);
+        matrix_destroy(S);
+        matrix_destroy(E);
+        matrix_destroy(X);
+        matrix_destroy(Y);
+    }
+
     /* ---------- TESTE: transposta ---------- */
     ASSERT(matrix_transpose(A, &C) == 0, "Falha em matrix_transpose");
 
@@ -73,6 +277,1240 @@ int main(void) {
     ASSERT(assert_elem(C, 2, 1, 12.0f) == 0, "Erro A*B (2,1)");
     ASSERT(assert_elem(C, 2, 2, 0.0f) == 0, "Erro A*B (2,2)");
 
+    matrix_destroy(C);
+    C = NULL;
+
+    /* ---------- TESTE: multiplicação com cancelamento ---------- */
+    {
+        Matrix *P = init_matrix(2, 3);
+        Matrix *Q = init_matrix(3, 3);
+        ASSERT(P && Q, "Falha ao criar P ou Q");
+        matrix_setelem(P, 1, 1, 1.0f);
+        matrix_setelem(P, 1, 2, 1.0f);
+        matrix_setelem(Q, 1, 3, 2.0f);
+        matrix_setelem(Q, 1, 1, 1.0f);
+        matrix_setelem(Q, 2, 3, -2.0f);
+        matrix_setelem(Q, 2, 2, 7.0f);
+
+        ASSERT(matrix_multiply(P, Q, &C) == 0, "Falha em P*Q");
+        ASSERT(assert_elem(C, 1, 1, 1.0f) == 0, "Erro P*Q (1,1)");
+        ASSERT(assert_elem(C, 1, 2, 7.0f) == 0, "Erro P*Q (1,2)");
+        ASSERT(C->mat[0]->prox->prox == NULL, "P*Q (1,3) deveria ser removido");
+        ASSERT(C->mat[0]->coluna == 1 && C->mat[0]->prox->coluna == 2, "P*Q fora de ordem");
+        ASSERT(C->mat[1] == NULL, "P*Q linha 2 deveria ser vazia");
+
+        matrix_destroy(C);
+        matrix_destroy(P);
+        matrix_destroy(Q);
+        C = NULL;
+    }
+
+    /* ---------- TESTE: alocador de nós ---------- */
+    {
+        Matrix *P = init_matrix(3, 3);
+        ASSERT(P, "Falha ao criar P");
+        ASSERT(matrix_setelem(P, 1, 1, 1.0f) == 0, "Falha set P(1,1)");
+        ASSERT(matrix_setelem(P, 2, 2, 2.0f) == 0, "Falha set P(2,2)");
+        POINT removido = P->mat[1];
+        ASSERT(matrix_setelem(P, 2, 2, 0.0f) == 0, "Falha remover P(2,2)");
+        ASSERT(P->pool.liberados == 1, "Nó removido nao voltou ao pool");
+        ASSERT(matrix_setelem(P, 3, 1, 5.0f) == 0, "Falha set P(3,1)");
+        ASSERT(P->mat[2] == removido, "Nó livre nao foi reaproveitado");
+        ASSERT(P->pool.nslabs == 1, "Pool deveria ter um unico slab");
+        ASSERT(assert_elem(P, 3, 1, 5.0f) == 0, "Erro P(3,1)");
+        matrix_destroy(P);
+    }
+
+    /* ---------- TESTE: índice por linha ---------- */
+    {
+        Matrix *X = init_matrix(5, 300), *R = init_matrix(5, 300);
+        ASSERT(X && R, "Falha ao criar X/R");
+        fill_random(X, 11u, 30);
+        fill_random(R, 11u, 30);
+        ASSERT(matrix_index_enable(X) == 0 && X->indice, "Falha em matrix_index_enable");
+
+        unsigned s = 99u;
+        for (int t = 0; t < 4000; t++) {
+            s = s * 1103515245u + 12345u;
+            int i = (int)((s >> 8) % 5) + 1;
+            int j = (int)((s >> 12) % 300) + 1;
+            float v = (float)((int)((s >> 20) % 7) - 3);
+            if (t % 3) {
+                ASSERT(matrix_setelem(X, i, j, v) == 0 && matrix_setelem(R, i, j, v) == 0, "Falha em setelem indexado");
+            } else {
+                ASSERT(matrix_addelem(X, i, j, v) == 0 && matrix_addelem(R, i, j, v) == 0, "Falha em addelem indexado");
+            }
+        }
+        ASSERT(same_matrix(X, R), "Matriz indexada difere da referencia");
+
+        for (int i = 0; i < 5; i++) {
+            int k = 0;
+            for (POINT p = X->mat[i]; p; p = p->prox, k++) {
+                ASSERT(k < X->indice[i].n && X->indice[i].nos[k] == p && X->indice[i].colunas[k] == p->coluna,
+                       "Indice fora de sincronia com a lista");
+            }
+            ASSERT(k == X->indice[i].n, "Tamanho do indice incorreto");
+        }
+        for (int i = 1; i <= 5; i++) {
+            for (int j = 1; j <= 300; j++) {
+                float a = 0.0f, b = 0.0f;
+                matrix_getelem(X, i, j, &a);
+                matrix_getelem(R, i, j, &b);
+                ASSERT(a == b, "getelem indexado difere");
+            }
+        }
+
+        matrix_index_disable(X);
+        ASSERT(!X->indice && same_matrix(X, R), "Desligar o indice nao deveria alterar a matriz");
+        matrix_destroy(X);
+        matrix_destroy(R);
+    }
+
+    /* ---------- TESTE: operações em lote ---------- */
+    {
+        enum { K = 3000 };
+        static int is[K], js[K];
+        static float vs[K], out[K];
+        unsigned s = 5u;
+        for (int t = 0; t < K; t++) {
+            s = s * 1103515245u + 12345u;
+            is[t] = (int)((s >> 8) % 40) + 1;
+            js[t] = (int)((s >> 14) % 60) + 1;
+            vs[t] = (float)((int)((s >> 20) % 5) - 2);
+        }
+
+        Matrix *R = init_matrix(40, 60), *X = init_matrix(40, 60), *Y = init_matrix(40, 60);
+        ASSERT(R && X && Y, "Falha ao criar R/X/Y");
+        fill_random(R, 3u, 20);
+        fill_random(X, 3u, 20);
+        fill_random(Y, 3u, 20);
+        ASSERT(matrix_index_enable(Y) == 0, "Falha ao ligar indice de Y");
+
+        for (int t = 0; t < K; t++) matrix_setelem(R, is[t], js[t], vs[t]);
+        ASSERT(matrix_setelem_batch(X, is, js, vs, K) == 0, "Falha em matrix_setelem_batch");
+        ASSERT(same_matrix(X, R), "Lote difere de setelem sequencial");
+        ASSERT(matrix_setelem_batch_parallel(Y, is, js, vs, K, 4) == 0, "Falha em matrix_setelem_batch_parallel");
+        ASSERT(same_matrix(Y, R), "Lote paralelo difere de setelem sequencial");
+
+        float v = 0.0f;
+        ASSERT(matrix_setelem(Y, 7, 9, 4.5f) == 0 && matrix_getelem(Y, 7, 9, &v) == 0 && v == 4.5f,
+               "Indice invalido depois do lote paralelo");
+
+        ASSERT(matrix_getelem_batch(R, is, js, K, out) == 0, "Falha em matrix_getelem_batch");
+        for (int t = 0; t < K; t++) {
+            matrix_getelem(R, is[t], js[t], &v);
+            ASSERT(out[t] == v, "getelem em lote difere");
+        }
+
+        int ruim[] = {41};
+        ASSERT(matrix_setelem_batch(X, ruim, js, vs, 1) == 2, "Indice fora dos limites deveria falhar");
+
+        matrix_destroy(R);
+        matrix_destroy(X);
+        matrix_destroy(Y);
+    }
+
+    /* ---------- TESTE: operações compostas ---------- */
+    {
+        Matrix *P = init_matrix(30, 20), *Q = init_matrix(20, 25);
+        Matrix *C1 = init_matrix(30, 25), *C2 = init_matrix(30, 25), *C3 = init_matrix(30, 25);
+        ASSERT(P && Q && C1 && C2 && C3, "Falha ao criar matrizes compostas");
+        fill_random(P, 21u, 25);
+        fill_random(Q, 22u, 25);
+        fill_random(C1, 23u, 30);
+        fill_random(C2, 23u, 30);
+        fill_random(C3, 24u, 30);
+
+        Matrix *S = NULL, *T = NULL, *U = NULL;
+        const Matrix *tres[] = {C1, C3, C2};
+        ASSERT(matrix_add_n(tres, NULL, 3, &S) == 0, "Falha em matrix_add_n");
+        ASSERT(matrix_add(C1, C3, &T) == 0 && matrix_add(T, C2, &U) == 0, "Falha na soma encadeada");
+        ASSERT(same_matrix(S, U), "matrix_add_n difere da soma encadeada");
+        matrix_destroy(S);
+        matrix_destroy(T);
+        matrix_destroy(U);
+
+        /* C1 <- 2 * P * Q - 3 * C1, comparada com a combinação de P * Q e C2 (cópia de C1) */
+        Matrix *PQ = NULL;
+        ASSERT(matrix_multiply(P, Q, &PQ) == 0, "Falha em P*Q");
+        const Matrix *dois[] = {PQ, C2};
+        const float coef[] = {2.0f, -3.0f};
+        ASSERT(matrix_add_n(dois, coef, 2, &S) == 0, "Falha em matrix_add_n com coeficientes");
+        ASSERT(matrix_index_enable(C1) == 0, "Falha ao ligar indice de C1");
+        ASSERT(matrix_gemm(2.0f, P, Q, -3.0f, C1) == 0, "Falha em matrix_gemm");
+        ASSERT(same_matrix(C1, S), "matrix_gemm difere de 2PQ - 3C");
+        float v = 0.0f;
+        ASSERT(matrix_setelem(C1, 4, 4, 0.25f) == 0 && matrix_getelem(C1, 4, 4, &v) == 0 && v == 0.25f,
+               "Indice invalido depois de matrix_gemm");
+        matrix_destroy(S);
+
+        ASSERT(matrix_gemm(1.0f, P, Q, 0.0f, C3) == 0 && same_matrix(C3, PQ), "matrix_gemm com beta 0 difere de P*Q");
+        ASSERT(matrix_gemm(1.0f, P, Q, 1.0f, (Matrix*)Q) == 1, "C igual a B deveria falhar");
+
+        /* Pᵀ * C2 sem montar Pᵀ */
+        ASSERT(matrix_multiply_tn(P, C2, &S) == 0, "Falha em matrix_multiply_tn");
+        ASSERT(matrix_transpose(P, &T) == 0 && matrix_multiply(T, C2, &U) == 0, "Falha em P^T * C2");
+        ASSERT(same_matrix(S, U), "matrix_multiply_tn difere de P^T * C2");
+        matrix_destroy(S);
+        matrix_destroy(T);
+        matrix_destroy(U);
+
+        matrix_destroy(PQ);
+        matrix_destroy(P);
+        matrix_destroy(Q);
+        matrix_destroy(C1);
+        matrix_destroy(C2);
+        matrix_destroy(C3);
+    }
+
+    /* ---------- TESTE: produto simbólico/numérico ---------- */
+    {
+        Matrix *P = init_matrix(25, 30), *Q = init_matrix(30, 20);
+        ASSERT(P && Q, "Falha ao criar P/Q");
+        fill_random(P, 31u, 20);
+        fill_random(Q, 32u, 20);
+
+        PlanoProduto *plano = NULL;
+        Matrix *R = NULL, *Ref = NULL;
+        ASSERT(matrix_multiply_symbolic(P, Q, &plano, &R) == 0, "Falha em matrix_multiply_symbolic");
+        ASSERT(matrix_multiply_numeric(plano, P, Q, R) == 0, "Falha em matrix_multiply_numeric");
+        ASSERT(matrix_multiply(P, Q, &Ref) == 0 && same_values(R, Ref), "Produto numerico difere de P*Q");
+        matrix_destroy(Ref);
+
+        long long alocados = R->pool.alocados;
+        int nslabs = R->pool.nslabs;
+        for (int rodada = 1; rodada <= 3; rodada++) {
+            for (int i = 0; i < P->linhas; i++) {
+                for (POINT p = P->mat[i]; p; p = p->prox) p->valor = (float)((p->coluna * rodada + i) % 7 + 1);
+            }
+            ASSERT(matrix_multiply_numeric(plano, P, Q, R) == 0, "Falha na repeticao numerica");
+            ASSERT(matrix_multiply(P, Q, &Ref) == 0 && same_values(R, Ref), "Repeticao numerica difere de P*Q");
+            matrix_destroy(Ref);
+        }
+        ASSERT(R->pool.alocados == alocados && R->pool.nslabs == nslabs, "Fase numerica nao deveria alocar nos");
+
+        for (int j = 1; j <= P->colunas; j++) matrix_setelem(P, 1, j, 1.0f);
+        ASSERT(matrix_multiply_numeric(plano, P, Q, R) == 2, "Estrutura diferente deveria ser rejeitada");
+
+        plano_produto_destroy(plano);
+        matrix_destroy(R);
+        matrix_destroy(P);
+        matrix_destroy(Q);
+    }
+
+    /* ---------- TESTE: transposta em blocos ---------- */
+    {
+        Matrix *P = init_matrix(30, 45);
+        ASSERT(P, "Falha ao criar P");
+        fill_random(P, 4u, 20);
+
+        Matrix *S = NULL, *T = NULL, *U = NULL;
+        ASSERT(matrix_transpose(P, &S) == 0, "Falha em P^T");
+        ASSERT(matrix_transpose_blocked(P, 7, &T) == 0, "Falha em P^T em blocos");
+        ASSERT(same_matrix(S, T), "P^T em blocos difere de P^T");
+        ASSERT(matrix_transpose(S, &U) == 0, "Falha em (P^T)^T");
+        ASSERT(same_matrix(P, U), "(P^T)^T difere de P");
+
+        matrix_destroy(S);
+        matrix_destroy(T);
+        matrix_destroy(U);
+        matrix_destroy(P);
+    }
+
+    /* ---------- TESTE: paralelo ---------- */
+    {
+        Matrix *P = init_matrix(60, 40);
+        Matrix *Q = init_matrix(40, 50);
+        Matrix *R = init_matrix(60, 40);
+        ASSERT(P && Q && R, "Falha ao criar P, Q ou R");
+        fill_random(P, 1u, 15);
+        fill_random(Q, 2u, 20);
+        fill_random(R, 3u, 15);
+
+        Matrix *S = NULL, *T = NULL;
+        ASSERT(matrix_multiply(P, Q, &S) == 0, "Falha em P*Q serial");
+        ASSERT(matrix_multiply_parallel(P, Q, &T, 4) == 0, "Falha em P*Q paralelo");
+        ASSERT(same_matrix(S, T), "P*Q paralelo difere do serial");
+        matrix_destroy(S);
+        matrix_destroy(T);
+
+        ASSERT(matrix_add(P, R, &S) == 0, "Falha em P+R serial");
+        ASSERT(matrix_add_parallel(P, R, &T, 3) == 0, "Falha em P+R paralelo");
+        ASSERT(same_matrix(S, T), "P+R paralelo difere do serial");
+        matrix_destroy(S);
+        matrix_destroy(T);
+
+        matrix_destroy(P);
+        matrix_destroy(Q);
+        matrix_destroy(R);
+    }
+
+    /* ---------- TESTE: SpMV paralelo ---------- */
+    {
+        /* linha 1 com quase todos os não nulos: o caminho deve dividi-la entre threads */
+        Matrix *P = init_matrix(200, 300);
+        MatrixCSR *CP = NULL;
+        ASSERT(P, "Falha ao criar P");
+        for (int j = 1; j <= 300; j++) matrix_setelem(P, 1, j, (float)(j % 7 - 3));
+        for (int i = 2; i <= 200; i++) {
+            matrix_setelem(P, i, i, 2.0f);
+            matrix_setelem(P, i, (i * 7) % 300 + 1, -1.0f);
+        }
+        ASSERT(csr_from_matrix(P, &CP) == 0, "Falha em csr_from_matrix(P)");
+
+        float x[300], y_ref[200], y[200];
+        for (int j = 0; j < 300; j++) x[j] = (float)(j % 5 - 2);
+        ASSERT(csr_spmv(CP, x, y_ref) == 0, "Falha em csr_spmv");
+
+        int nts[] = {1, 2, 3, 4, 7, 1000};
+        for (int u = 0; u < 6; u++) {
+            PlanoSpmv *plano = NULL;
+            ASSERT(plano_spmv_init(CP, nts[u], &plano) == 0, "Falha em plano_spmv_init");
+            ASSERT(csr_spmv_parallel(plano, x, y) == 0, "Falha em csr_spmv_parallel");
+            for (int i = 0; i < 200; i++) ASSERT(y[i] == y_ref[i], "csr_spmv_parallel difere de csr_spmv");
+
+            /* o plano reaproveita as mesmas threads nas chamadas seguintes */
+            for (int rep = 0; rep < 3; rep++) {
+                for (int i = 0; i < 200; i++) y[i] = -1.0f;
+                ASSERT(csr_spmv_parallel(plano, x, y) == 0, "Falha em csr_spmv_parallel repetido");
+                for (int i = 0; i < 200; i++) ASSERT(y[i] == y_ref[i], "csr_spmv_parallel repetido difere de csr_spmv");
+            }
+
+            long long total = (long long)CP->linhas + CP->nnz;
+            for (int t = 0; t < plano->nthreads; t++) {
+                long long passos = (plano->linha[t + 1] - plano->linha[t]) + (plano->pos[t + 1] - plano->pos[t]);
+                long long alvo = total / plano->nthreads;
+                ASSERT(passos >= alvo && passos <= alvo + 1, "Trechos do caminho desbalanceados");
+                ASSERT(plano->ns_thread[t] >= 0, "Tempo por thread invalido");
+            }
+            plano_spmv_destroy(plano);
+        }
+
+        csr_destroy(CP);
+        matrix_destroy(P);
+    }
+
+    /* ---------- TESTE: SpMM (matriz esparsa x matriz densa) ---------- */
+    {
+        Matrix *P = init_matrix(90, 70);
+        MatrixCSR *CP = NULL;
+        ASSERT(P, "Falha ao criar P");
+        fill_random(P, 31u, 15);
+        for (int j = 1; j <= 70; j++) matrix_setelem(P, 5, j, (float)(j % 3 + 1));
+        ASSERT(csr_from_matrix(P, &CP) == 0, "Falha em csr_from_matrix(P)");
+
+        /* valores inteiros pequenos: todas as versões dão o resultado exato */
+        enum { KMAX = 130 };
+        float *Bd = (float*)malloc(70 * (KMAX + 3) * sizeof(float));
+        float *Cd = (float*)malloc(90 * (KMAX + 5) * sizeof(float));
+        float *Cr = (float*)malloc(90 * (KMAX + 5) * sizeof(float));
+        ASSERT(Bd && Cd && Cr, "Falha ao alocar B/C");
+
+        int ks[] = {1, 8, 17, 57, 64, 100, KMAX};
+        for (int u = 0; u < 7; u++) {
+            int k = ks[u], ldb = k + 3, ldc = k + 5;
+            for (int t = 0; t < 70 * ldb; t++) Bd[t] = (float)(t % 7 - 3);
+
+            for (int i = 0; i < 90; i++) {
+                for (int j = 0; j < ldc; j++) Cr[i * ldc + j] = j < k ? 0.0f : -7.0f;
+                for (POINT p = P->mat[i]; p; p = p->prox) {
+                    for (int j = 0; j < k; j++) Cr[i * ldc + j] += p->valor * Bd[(p->coluna - 1) * ldb + j];
+                }
+            }
+
+            for (int t = 0; t < 90 * ldc; t++) Cd[t] = -7.0f;
+            ASSERT(matrix_spmm(P, Bd, k, ldb, Cd, ldc) == 0, "Falha em matrix_spmm");
+            ASSERT(memcmp(Cd, Cr, 90 * ldc * sizeof(float)) == 0, "matrix_spmm difere da referencia");
+
+            for (int nivel = SIMD_ESCALAR; nivel <= SIMD_AVX512; nivel++) {
+                simd_set_nivel((SimdNivel)nivel);
+                for (int t = 0; t < 90 * ldc; t++) Cd[t] = -7.0f;
+                ASSERT(csr_spmm(CP, Bd, k, ldb, Cd, ldc) == 0, "Falha em csr_spmm");
+                ASSERT(memcmp(Cd, Cr, 90 * ldc * sizeof(float)) == 0, "csr_spmm difere da referencia");
+            }
+            simd_set_nivel(SIMD_AVX512);
+
+            int nts[] = {2, 3, 7, 1000};
+            for (int v = 0; v < 4; v++) {
+                for (int t = 0; t < 90 * ldc; t++) Cd[t] = -7.0f;
+                ASSERT(csr_spmm_parallel(CP, Bd, k, ldb, Cd, ldc, nts[v]) == 0, "Falha em csr_spmm_parallel");
+                ASSERT(memcmp(Cd, Cr, 90 * ldc * sizeof(float)) == 0, "csr_spmm_parallel difere da referencia");
+            }
+        }
+
+        ASSERT(csr_spmm(CP, Bd, 8, 7, Cd, 8) == 1, "ldb < k deveria falhar");
+        ASSERT(matrix_spmm(P, Bd, 0, 8, Cd, 8) == 1, "k = 0 deveria falhar");
+        ASSERT(csr_spmm_parallel(CP, NULL, 8, 8, Cd, 8, 2) == 1, "B NULL deveria falhar");
+
+        free(Bd);
+        free(Cd);
+        free(Cr);
+        csr_destroy(CP);
+        matrix_destroy(P);
+    }
+
+    /* ---------- TESTE: construção por triplas (COO) ---------- */
+    {
+        int is[] = {2, 1, 2, 1, 3, 1};
+        int js[] = {3, 2, 1, 2, 3, 1};
+        float vs[] = {4.0f, 1.0f, 6.0f, 2.0f, 0.0f, 7.0f};
+
+        ASSERT(matrix_from_coo(3, 3, is, js, vs, 6, &C) == 0, "Falha em matrix_from_coo");
+        ASSERT(assert_elem(C, 1, 1, 7.0f) == 0, "Erro COO (1,1)");
+        ASSERT(assert_elem(C, 1, 2, 3.0f) == 0, "Erro COO (1,2) repetido");
+        ASSERT(assert_elem(C, 2, 1, 6.0f) == 0, "Erro COO (2,1)");
+        ASSERT(assert_elem(C, 2, 3, 4.0f) == 0, "Erro COO (2,3)");
+        ASSERT(C->mat[2] == NULL, "COO (3,3) nulo deveria ser descartado");
+        ASSERT(C->mat[1]->coluna == 1, "COO linha 2 fora de ordem");
+        matrix_destroy(C);
+        C = NULL;
+
+        int fora[] = {4};
+        ASSERT(matrix_from_coo(3, 3, fora, js, vs, 1, &C) == 2 && !C, "COO fora dos limites");
+    }
+
+    /* ---------- TESTE: Matrix Market ---------- */
+    {
+        const char *arq = "teste_unitario.mtx.tmp";
+        Matrix *P = init_matrix(20, 15);
+        ASSERT(P, "Falha ao criar P");
+        fill_random(P, 5u, 25);
+        matrix_setelem(P, 1, 1, 0.1f);
+        matrix_setelem(P, 1, 2, -3.25e-7f);
+
+        ASSERT(matrix_write_mtx(arq, P) == 0, "Falha em matrix_write_mtx");
+        ASSERT(matrix_read_mtx(arq, &C) == 0, "Falha em matrix_read_mtx");
+        ASSERT(same_matrix(P, C), "Matriz lida difere da gravada");
+        matrix_destroy(C);
+        matrix_destroy(P);
+        C = NULL;
+
+        FILE *f = fopen(arq, "w");
+        ASSERT(f, "Falha ao criar arquivo .mtx");
+        fprintf(f, "%%%%MatrixMarket matrix coordinate pattern symmetric\n"
+                   "%% comentario\n"
+                   "3 3 3\n1 1\n3 1\n\n  3 2\n");
+        fclose(f);
+
+        ASSERT(matrix_read_mtx(arq, &C) == 0, "Falha ao ler .mtx simetrico");
+        ASSERT(assert_elem(C, 1, 1, 1.0f) == 0, "Erro mtx (1,1)");
+        ASSERT(assert_elem(C, 1, 3, 1.0f) == 0, "Erro mtx (1,3) simetrico");
+        ASSERT(assert_elem(C, 3, 1, 1.0f) == 0, "Erro mtx (3,1)");
+        ASSERT(assert_elem(C, 2, 3, 1.0f) == 0, "Erro mtx (2,3) simetrico");
+        ASSERT(assert_elem(C, 2, 2, 0.0f) == 0, "Erro mtx (2,2)");
+        matrix_destroy(C);
+        C = NULL;
+
+        f = fopen(arq, "w");
+        ASSERT(f, "Falha ao criar arquivo .mtx");
+        fprintf(f, "%%%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+        fclose(f);
+        ASSERT(matrix_read_mtx(arq, &C) == 2 && !C, "Formato array deveria ser rejeitado");
+
+        /* 25 dígitos: estoura long long (e, sem verificação, daria 3 ao dar a volta em 2^64) */
+        f = fopen(arq, "w");
+        ASSERT(f, "Falha ao criar arquivo .mtx");
+        fprintf(f, "%%%%MatrixMarket matrix coordinate real general\n1000016442979868502654979 3 1\n1 1 1\n");
+        fclose(f);
+        ASSERT(matrix_read_mtx(arq, &C) == 2 && !C, "Dimensao com 25 digitos deveria ser rejeitada");
+
+        /* no expoente, o estouro satura: 1e-(25 dígitos) vira 0 */
+        f = fopen(arq, "w");
+        ASSERT(f, "Falha ao criar arquivo .mtx");
+        fprintf(f, "%%%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1e-1000000000000000000000000\n2 2 5\n");
+        fclose(f);
+        ASSERT(matrix_read_mtx(arq, &C) == 0, "Expoente com 25 digitos deveria ser aceito");
+        ASSERT(assert_elem(C, 1, 1, 0.0f) == 0, "Erro mtx (1,1) com expoente saturado");
+        ASSERT(assert_elem(C, 2, 2, 5.0f) == 0, "Erro mtx (2,2) com expoente saturado");
+        matrix_destroy(C);
+        C = NULL;
+
+        remove(arq);
+    }
+
+    /* ---------- TESTE: formato binário mapeado ---------- */
+    {
+        const char *arq = "teste_unitario.bin.tmp";
+        Matrix *P = init_matrix(25, 25);
+        ASSERT(P, "Falha ao criar P");
+        fill_random(P, 6u, 20);
+
+        MatrixCSR *CP = NULL, *MP = NULL, *X = NULL, *Y = NULL;
+        ASSERT(csr_from_matrix(P, &CP) == 0, "Falha em csr_from_matrix(P)");
+        ASSERT(csr_save_binary(arq, CP) == 0, "Falha em csr_save_binary");
+        ASSERT(csr_map_binary(arq, &MP) == 0, "Falha em csr_map_binary");
+        ASSERT(MP->mapa && MP->nnz == CP->nnz, "Erro no cabecalho mapeado");
+
+        for (int i = 1; i <= 25; i++) {
+            for (int j = 1; j <= 25; j++) {
+                float esperado;
+                matrix_getelem(P, i, j, &esperado);
+                ASSERT(assert_csr_elem(MP, i, j, esperado) == 0, "Erro elemento mapeado");
+            }
+        }
+
+        ASSERT(csr_multiply(CP, CP, &X) == 0, "Falha em P*P em memoria");
+        ASSERT(csr_multiply(MP, MP, &Y) == 0, "Falha em P*P mapeado");
+        ASSERT(X->nnz == Y->nnz, "P*P mapeado difere");
+        for (int k = 0; k < X->nnz; k++) {
+            ASSERT(X->col_idx[k] == Y->col_idx[k] && X->values[k] == Y->values[k], "P*P mapeado difere");
+        }
+
+        csr_destroy(X);
+        csr_destroy(Y);
+        csr_destroy(MP);
+
+        /* arquivos adulterados: deslocamento que estoura, coluna fora dos limites, colunas fora de ordem */
+        FILE *f;
+        uint64_t off_col_idx;
+        int lixo;
+        ASSERT(CP->row_ptr[1] - CP->row_ptr[0] >= 2, "Primeira linha de P com menos de 2 elementos");
+        for (int caso = 0; caso < 3; caso++) {
+            ASSERT(csr_save_binary(arq, CP) == 0, "Falha em csr_save_binary");
+            f = fopen(arq, "r+b");
+            ASSERT(f, "Falha ao abrir arquivo binario");
+            if (caso == 0) {
+                uint64_t off = UINT64_MAX - 63;
+                fseek(f, 32, SEEK_SET);
+                fwrite(&off, sizeof off, 1, f);
+            } else {
+                fseek(f, 40, SEEK_SET);
+                ASSERT(fread(&off_col_idx, sizeof off_col_idx, 1, f) == 1, "Falha ao ler cabecalho");
+                lixo = caso == 1 ? 1000000 : CP->col_idx[1];
+                fseek(f, (long)off_col_idx, SEEK_SET);
+                fwrite(&lixo, sizeof lixo, 1, f);
+            }
+            fclose(f);
+            ASSERT(csr_map_binary(arq, &MP) == 2 && !MP, "Arquivo adulterado deveria ser rejeitado");
+        }
+        csr_destroy(CP);
+        matrix_destroy(P);
+
+        f = fopen(arq, "wb");
+        ASSERT(f, "Falha ao criar arquivo binario");
+        fprintf(f, "isto nao e uma matriz binaria, apenas texto suficiente para o cabecalho......");
+        fclose(f);
+        ASSERT(csr_map_binary(arq, &MP) == 2 && !MP, "Arquivo invalido deveria ser rejeitado");
+
+        remove(arq);
+    }
+
+    /* ---------- TESTE: SpMV ---------- */
+    {
+        Matrix *P = init_matrix(40, 70);
+        MatrixCSR *CP = NULL;
+        ASSERT(P, "Falha ao criar P");
+        fill_random(P, 7u, 40);
+        ASSERT(csr_from_matrix(P, &CP) == 0, "Falha em csr_from_matrix(P)");
+
+        float x[70], xt[40], y_ref[70], y[70];
+        for (int j = 0; j < 70; j++) x[j] = (float)(j % 5 - 2);
+        for (int i = 0; i < 40; i++) xt[i] = (float)(i % 3 - 1);
+
+        ASSERT(matrix_spmv(P, x, y_ref) == 0, "Falha em matrix_spmv");
+        for (int nivel = SIMD_ESCALAR; nivel <= SIMD_AVX512; nivel++) {
+            simd_set_nivel((SimdNivel)nivel);
+            ASSERT(csr_spmv(CP, x, y) == 0, "Falha em csr_spmv");
+            for (int i = 0; i < 40; i++) ASSERT(y[i] == y_ref[i], "csr_spmv difere de matrix_spmv");
+        }
+
+        ASSERT(matrix_spmv_t(P, xt, y_ref) == 0, "Falha em matrix_spmv_t");
+        for (int nivel = SIMD_ESCALAR; nivel <= SIMD_AVX512; nivel++) {
+            simd_set_nivel((SimdNivel)nivel);
+            ASSERT(csr_spmv_t(CP, xt, y) == 0, "Falha em csr_spmv_t");
+            for (int j = 0; j < 70; j++) ASSERT(y[j] == y_ref[j], "csr_spmv_t difere de matrix_spmv_t");
+        }
+        simd_set_nivel(SIMD_AVX512);
+
+        Matrix *T = NULL;
+        ASSERT(matrix_transpose(P, &T) == 0, "Falha em P^T");
+        ASSERT(matrix_spmv(T, xt, y) == 0, "Falha em P^T * x");
+        for (int j = 0; j < 70; j++) ASSERT(y[j] == y_ref[j], "spmv_t difere de P^T * x");
+
+        matrix_destroy(T);
+        csr_destroy(CP);
+        matrix_destroy(P);
+    }
+
+    /* ---------- TESTE: BSR ---------- */
+    {
+        /* dimensões que não são múltiplas do bloco, para exercitar a borda */
+        Matrix *P = init_matrix(4 * BSR_BLOCO + 1, 3 * BSR_BLOCO + 2);
+        Matrix *Q = init_matrix(3 * BSR_BLOCO + 2, 2 * BSR_BLOCO + 3);
+        Matrix *S = init_matrix(4 * BSR_BLOCO + 1, 3 * BSR_BLOCO + 2);
+        ASSERT(P && Q && S, "Falha ao criar P/Q/S");
+        fill_random(P, 41u, 25);
+        fill_random(Q, 42u, 25);
+        fill_random(S, 43u, 25);
+
+        MatrixBSR *BP = NULL, *BQ = NULL, *BS = NULL, *BR = NULL;
+        Matrix *R = NULL, *Ref = NULL;
+        ASSERT(bsr_from_matrix(P, &BP) == 0, "Falha em bsr_from_matrix(P)");
+        ASSERT(bsr_from_matrix(Q, &BQ) == 0, "Falha em bsr_from_matrix(Q)");
+        ASSERT(bsr_from_matrix(S, &BS) == 0, "Falha em bsr_from_matrix(S)");
+        ASSERT(BP->blinhas == 5 && BP->bcolunas == 4, "Numero de blocos errado");
+
+        ASSERT(bsr_to_matrix(BP, &R) == 0 && same_matrix(P, R), "Ida e volta BSR difere");
+        matrix_destroy(R);
+
+        for (int i = 1; i <= P->linhas; i++) {
+            for (int j = 1; j <= P->colunas; j++) {
+                float esperado = 0.0f, obtido = 1.0f;
+                matrix_getelem(P, i, j, &esperado);
+                ASSERT(bsr_getelem(BP, i, j, &obtido) == 0 && obtido == esperado, "bsr_getelem difere");
+            }
+        }
+
+        ASSERT(bsr_add(BP, BS, &BR) == 0 && bsr_to_matrix(BR, &R) == 0, "Falha em bsr_add");
+        ASSERT(matrix_add(P, S, &Ref) == 0 && same_matrix(R, Ref), "bsr_add difere de matrix_add");
+        matrix_destroy(R);
+        matrix_destroy(Ref);
+        bsr_destroy(BR);
+
+        ASSERT(bsr_multiply(BP, BQ, &BR) == 0 && bsr_to_matrix(BR, &R) == 0, "Falha em bsr_multiply");
+        ASSERT(matrix_multiply(P, Q, &Ref) == 0 && same_matrix(R, Ref), "bsr_multiply difere de matrix_multiply");
+        matrix_destroy(R);
+        matrix_destroy(Ref);
+        bsr_destroy(BR);
+
+        float x[3 * BSR_BLOCO + 2], y_ref[4 * BSR_BLOCO + 1], y[4 * BSR_BLOCO + 1];
+        for (int j = 0; j < P->colunas; j++) x[j] = (float)(j % 5 - 2);
+        ASSERT(matrix_spmv(P, x, y_ref) == 0, "Falha em matrix_spmv");
+        for (int nivel = SIMD_ESCALAR; nivel <= SIMD_AVX512; nivel++) {
+            simd_set_nivel((SimdNivel)nivel);
+            ASSERT(bsr_spmv(BP, x, y) == 0, "Falha em bsr_spmv");
+            for (int i = 0; i < P->linhas; i++) ASSERT(y[i] == y_ref[i], "bsr_spmv difere de matrix_spmv");
+        }
+        simd_set_nivel(SIMD_AVX512);
+
+        Matrix *Z = init_matrix(3, 3);
+        ASSERT(Z && bsr_from_matrix(Z, &BR) == 0 && BR->nnzb == 0, "Matriz vazia deveria ter 0 blocos");
+        bsr_destroy(BR);
+        matrix_destroy(Z);
+        ASSERT(bsr_add(BP, BQ, &BR) == 1 && !BR, "Dimensoes incompativeis deveriam falhar");
+
+        bsr_destroy(BP);
+        bsr_destroy(BQ);
+        bsr_destroy(BS);
+        matrix_destroy(P);
+        matrix_destroy(Q);
+        matrix_destroy(S);
+    }
+
+    /* ---------- TESTE: solvers iterativos ---------- */
+    {
+        /* Laplaciano 2D (5 pontos) em uma grade 12 x 12: simétrica positiva definida */
+        enum { G = 12, N = G * G };
+        Matrix *L = init_matrix(N, N), *C = init_matrix(N, N);
+        ASSERT(L && C, "Falha ao criar L/C");
+        for (int gi = 0; gi < G; gi++) {
+            for (int gj = 0; gj < G; gj++) {
+                int i = gi * G + gj + 1;
+                matrix_setelem(L, i, i, 4.0f);
+                if (gj > 0) matrix_setelem(L, i, i - 1, -1.0f);
+                if (gj < G - 1) matrix_setelem(L, i, i + 1, -1.0f);
+                if (gi > 0) matrix_setelem(L, i, i - G, -1.0f);
+                if (gi < G - 1) matrix_setelem(L, i, i + G, -1.0f);
+            }
+        }
+        /* convecção-difusão 1D: não simétrica */
+        for (int i = 1; i <= N; i++) {
+            matrix_setelem(C, i, i, 3.0f);
+            if (i > 1) matrix_setelem(C, i, i - 1, -1.5f);
+            if (i < N) matrix_setelem(C, i, i + 1, -0.5f);
+        }
+
+        MatrixCSR *CL = NULL, *CC = NULL;
+        ASSERT(csr_from_matrix(L, &CL) == 0 && csr_from_matrix(C, &CC) == 0, "Falha em csr_from_matrix");
+
+        float um[N], b[N], bc[N], x[N];
+        for (int i = 0; i < N; i++) um[i] = 1.0f;
+        csr_spmv(CL, um, b);
+        csr_spmv(CC, um, bc);
+
+        SolverWork *w = solver_work_init(N, 500);
+        ASSERT(w, "Falha em solver_work_init");
+        SolverOpcoes op = {500, 1e-6, NULL, NULL, NULL};
+        SolverResultado res;
+
+        int iter[3];
+        for (int tipo = PRECOND_NENHUM; tipo <= PRECOND_ILU0; tipo++) {
+            Precondicionador *pc = NULL;
+            ASSERT(precond_init(CL, (PrecondTipo)tipo, &pc) == 0, "Falha em precond_init");
+            op.precond = pc;
+            memset(x, 0, sizeof(x));
+            ASSERT(solver_cg(CL, b, x, &op, w, &res) == 0, "CG deveria convergir");
+            ASSERT(res.residuo <= 1e-6 && perto_de_um(x, N, 1e-4f), "Solucao do CG errada");
+            ASSERT(res.ns_total > 0 && w->ns_iter[res.iteracoes - 1] > 0, "Tempos do CG nao registrados");
+            iter[tipo] = res.iteracoes;
+
+            memset(x, 0, sizeof(x));
+            ASSERT(solver_bicgstab(CC, bc, x, &op, w, &res) == 0, "BiCGSTAB deveria convergir");
+            ASSERT(perto_de_um(x, N, 1e-4f), "Solucao do BiCGSTAB errada");
+            precond_destroy(pc);
+        }
+        ASSERT(iter[PRECOND_ILU0] < iter[PRECOND_NENHUM], "ILU(0) deveria reduzir as iteracoes");
+
+        int limite = 3;
+        op.precond = NULL;
+        op.callback = para_depois_de;
+        op.dados = &limite;
+        memset(x, 0, sizeof(x));
+        ASSERT(solver_cg(CL, b, x, &op, w, &res) == 3 && res.iteracoes == 3, "Callback deveria interromper o CG");
+
+        op.callback = NULL;
+        op.max_iter = 501;
+        ASSERT(solver_cg(CL, b, x, &op, w, &res) == 1, "max_iter maior que o espaco de trabalho deveria falhar");
+
+        Precondicionador *pc = NULL;
+        matrix_setelem(L, 5, 5, 0.0f);
+        MatrixCSR *SemDiag = NULL;
+        ASSERT(csr_from_matrix(L, &SemDiag) == 0, "Falha em csr_from_matrix");
+        ASSERT(precond_init(SemDiag, PRECOND_JACOBI, &pc) == 2 && !pc, "Diagonal nula deveria falhar (Jacobi)");
+        ASSERT(precond_init(SemDiag, PRECOND_ILU0, &pc) == 2 && !pc, "Diagonal nula deveria falhar (ILU0)");
+
+        csr_destroy(SemDiag);
+        solver_work_destroy(w);
+        csr_destroy(CL);
+        csr_destroy(CC);
+        matrix_destroy(L);
+        matrix_destroy(C);
+    }
+
+    /* ---------- TESTE: reordenação ---------- */
+    {
+        /* Laplaciano 1D embaralhado: a RCM deve recuperar a banda 1 */
+        enum { N = 60 };
+        Matrix *T = init_matrix(N, N), *A = NULL, *B = NULL, *V = NULL;
+        ASSERT(T, "Falha ao criar T");
+        for (int i = 1; i <= N; i++) {
+            matrix_setelem(T, i, i, 2.0f);
+            if (i > 1) matrix_setelem(T, i, i - 1, -1.0f);
+            if (i < N) matrix_setelem(T, i, i + 1, -1.0f);
+        }
+
+        int embaralha[N], perm[N], banda = -1;
+        long long perfil = -1;
+        for (int i = 0; i < N; i++) embaralha[i] = (i * 37) % N;
+        ASSERT(matrix_permute(T, embaralha, &A) == 0, "Falha em matrix_permute");
+        ASSERT(matrix_bandwidth(T, &banda, &perfil) == 0 && banda == 1 && perfil == N - 1, "Banda/perfil de T errados");
+        ASSERT(matrix_bandwidth(A, &banda, NULL) == 0 && banda > 10, "A deveria ter banda larga");
+
+        RelatorioOrdem rel;
+        ASSERT(matrix_reorder(A, ORDEM_RCM, perm, &B, &rel) == 0, "Falha em matrix_reorder");
+        ASSERT(rel.banda_antes == banda && rel.banda_depois == 1, "RCM deveria recuperar a banda 1");
+        ASSERT(rel.perfil_depois < rel.perfil_antes, "RCM deveria reduzir o perfil");
+
+        /* A x = Pᵀ (B (P x)) */
+        float x[N], xp[N], yp[N], y[N], y_ref[N];
+        for (int i = 0; i < N; i++) x[i] = (float)(i % 7 - 3);
+        ASSERT(matrix_spmv(A, x, y_ref) == 0, "Falha em matrix_spmv(A)");
+        ASSERT(vector_permute(x, perm, N, xp) == 0, "Falha em vector_permute");
+        ASSERT(matrix_spmv(B, xp, yp) == 0, "Falha em matrix_spmv(B)");
+        ASSERT(vector_unpermute(yp, perm, N, y) == 0, "Falha em vector_unpermute");
+        for (int i = 0; i < N; i++) ASSERT(y[i] == y_ref[i], "SpMV reordenado difere");
+
+        /* desfazer a permutação devolve A */
+        int inv[N];
+        for (int i = 0; i < N; i++) inv[perm[i]] = i;
+        ASSERT(matrix_permute(B, inv, &V) == 0 && same_matrix(A, V), "Permutacao inversa deveria devolver A");
+        matrix_destroy(V);
+        matrix_destroy(B);
+
+        ASSERT(reorder_degree(A, perm) == 0, "Falha em reorder_degree");
+        ASSERT(perm[0] == embaralha[0] || perm[0] == embaralha[N - 1], "Extremos tem o menor grau");
+
+        /* componentes desconexos e linhas vazias */
+        Matrix *D = init_matrix(5, 5);
+        matrix_setelem(D, 1, 4, 1.0f);
+        matrix_setelem(D, 2, 2, 1.0f);
+        ASSERT(reorder_rcm(D, perm) == 0, "Falha em reorder_rcm (desconexo)");
+        int visto[5] = {0};
+        for (int i = 0; i < 5; i++) visto[perm[i]]++;
+        for (int i = 0; i < 5; i++) ASSERT(visto[i] == 1, "RCM deveria gerar uma permutacao");
+
+        perm[1] = perm[0];
+        ASSERT(matrix_permute(D, perm, &V) == 2 && !V, "Permutacao invalida deveria falhar");
+        Matrix *R = init_matrix(3, 4);
+        ASSERT(reorder_rcm(R, perm) == 1, "Matriz nao quadrada deveria falhar");
+
+        matrix_destroy(R);
+        matrix_destroy(D);
+        matrix_destroy(A);
+        matrix_destroy(T);
+    }
+
+    /* ---------- TESTE: instrumentação ---------- */
+    {
+        /* Só confere contagens quando compilado com -DMATRIX_INSTRUMENT; sem a flag tudo é zero */
+        Matrix *X = init_matrix(3, 3), *Y = init_matrix(3, 3), *S = init_matrix(3, 3), *Z = NULL;
+        ASSERT(X && Y && S, "Falha ao criar X/Y/S");
+        matrix_setelem(X, 1, 1, 1.0f);
+        matrix_setelem(X, 1, 3, 2.0f);
+        matrix_setelem(X, 2, 2, 3.0f);
+        matrix_setelem(Y, 1, 1, -1.0f);
+        matrix_setelem(Y, 1, 2, 4.0f);
+        matrix_setelem(Y, 3, 3, 5.0f);
+
+        instr_zera();
+        ASSERT(matrix_add(X, Y, &Z) == 0, "Falha em X+Y");
+        matrix_destroy(Z);
+        ASSERT(matrix_multiply(X, Y, &Z) == 0, "Falha em X*Y");
+        matrix_destroy(Z);
+        ASSERT(matrix_transpose(X, &Z) == 0, "Falha em Xt");
+        matrix_destroy(Z);
+        matrix_setelem(S, 1, 3, 1.0f);
+        matrix_setelem(S, 1, 1, 1.0f);
+        matrix_setelem(S, 1, 3, 0.0f);
+
+        InstrContadores c[INSTR_NOPS];
+        for (int op = 0; op < INSTR_NOPS; op++) ASSERT(instr_le((InstrOp)op, &c[op]) == 0, "Falha em instr_le");
+        ASSERT(instr_le(INSTR_NOPS, &c[0]) == 2, "instr_le com op invalida deveria falhar");
+
+        if (instr_ativo()) {
+            /* soma: 6 nós visitados, 1 par somado (que zera), 4 nós no resultado */
+            ASSERT(c[INSTR_ADD].chamadas == 1 && c[INSTR_ADD].passos == 6, "Contadores de add errados");
+            ASSERT(c[INSTR_ADD].flops == 1 && c[INSTR_ADD].nos_alocados == 4, "Flops/nos de add errados");
+            /* produto: 3 nós de X e 3 produtos parciais */
+            ASSERT(c[INSTR_MULTIPLY].produtos == 3 && c[INSTR_MULTIPLY].passos == 6, "Contadores de multiply errados");
+            ASSERT(c[INSTR_MULTIPLY].flops == 6 && c[INSTR_MULTIPLY].nos_alocados == 3, "Flops/nos de multiply errados");
+            ASSERT(c[INSTR_TRANSPOSE].chamadas == 1 && c[INSTR_TRANSPOSE].nos_alocados == 3, "Contadores de transpose errados");
+            /* setelem: só a remoção anda um nó na lista */
+            ASSERT(c[INSTR_SETELEM].chamadas == 3 && c[INSTR_SETELEM].passos == 1, "Contadores de setelem errados");
+            ASSERT(c[INSTR_SETELEM].nos_alocados == 2 && c[INSTR_SETELEM].nos_liberados == 1, "Nos de setelem errados");
+        } else {
+            for (int op = 0; op < INSTR_NOPS; op++) ASSERT(c[op].chamadas == 0 && c[op].passos == 0, "Contadores deveriam ser zero");
+        }
+
+        /* linha com coluna fora dos limites: a chamada falha e não entra nos contadores */
+        Acumulador ac;
+        POINT saida = NULL;
+        InstrContadores depois;
+        ASSERT(acumulador_init(&ac, 3) == 0, "Falha em acumulador_init");
+        X->mat[1]->coluna = 9;
+        ASSERT(matrix_multiply_row(X, Y, 1, &ac, NULL, &saida) == 2 && !saida, "Coluna fora dos limites deveria falhar");
+        X->mat[1]->coluna = 2;
+        acumulador_free(&ac);
+        ASSERT(instr_le(INSTR_MULTIPLY, &depois) == 0, "Falha em instr_le");
+        ASSERT(depois.passos == c[INSTR_MULTIPLY].passos && depois.produtos == c[INSTR_MULTIPLY].produtos,
+               "Linha com erro nao deveria ser contada");
+
+        char buf[1024] = {0};
+        FILE *f = tmpfile();
+        ASSERT(f && instr_dump_json(f) == 0, "Falha em instr_dump_json");
+        rewind(f);
+        ASSERT(fgets(buf, sizeof buf, f), "Falha ao ler o JSON");
+        fclose(f);
+        ASSERT(strstr(buf, instr_ativo() ? "\"instrumentado\":true" : "\"instrumentado\":false"), "JSON sem o estado");
+        ASSERT(strstr(buf, "\"setelem\":{\"chamadas\":"), "JSON sem setelem");
+
+        instr_zera();
+        ASSERT(instr_le(INSTR_ADD, &c[0]) == 0 && c[0].chamadas == 0, "instr_zera nao zerou");
+
+        matrix_destroy(S);
+        matrix_destroy(Y);
+        matrix_destroy(X);
+    }
+
+    /* ---------- TESTE: representação híbrida ---------- */
+    {
+        /* linhas esparsas aleatórias, uma linha e uma coluna quase cheias */
+        enum { N = 150 };
+        Matrix *X = init_matrix(N, N), *Y = init_matrix(N, N), *Z = NULL, *W = NULL, *V = NULL;
+        ASSERT(X && Y, "Falha ao criar X/Y");
+        fill_random(X, 21u, 4);
+        fill_random(Y, 22u, 4);
+        for (int j = 1; j <= N; j++) {
+            if (j % 10) matrix_setelem(X, 7, j, (float)(j % 5 + 1));
+            if (j % 9) matrix_setelem(Y, j, 3, (float)(j % 4 + 1));
+            matrix_setelem(Y, 7, j, -(float)(j % 5 + 1));
+        }
+
+        MatrixHibrida *HX = NULL, *HY = NULL, *HR = NULL;
+        ASSERT(hibrida_from_matrix(X, &HX) == 0 && hibrida_from_matrix(Y, &HY) == 0, "Falha em hibrida_from_matrix");
+        ASSERT(HX->rows[6].densa && HY->rows[6].densa && !HX->rows[0].densa, "Linha 7 deveria ser densa");
+        ASSERT(hibrida_linhas_densas(HX) == 1, "Apenas a linha 7 de X deveria ser densa");
+
+        float v = -1.0f;
+        ASSERT(hibrida_getelem(HX, 7, 11, &v) == 0 && v == 2.0f, "Erro HX(7,11)");
+        ASSERT(hibrida_getelem(HX, 7, 10, &v) == 0 && v == 0.0f, "Erro HX(7,10)");
+        ASSERT(hibrida_getelem(HX, N + 1, 1, &v) == 1, "getelem fora dos limites deveria falhar");
+
+        /* esparsa + esparsa, densa + esparsa e densa + densa (linha 7 cancela em parte) */
+        ASSERT(hibrida_add(HX, HY, &HR) == 0, "Falha em hibrida_add");
+        ASSERT(matrix_add(X, Y, &Z) == 0 && hibrida_to_matrix(HR, &W) == 0, "Falha ao converter a soma");
+        ASSERT(same_matrix(Z, W), "hibrida_add difere de matrix_add");
+        ASSERT(!HR->rows[6].densa, "Linha 7 da soma deveria voltar a esparsa");
+        hibrida_destroy(HR);
+        matrix_destroy(Z);
+        matrix_destroy(W);
+
+        ASSERT(hibrida_multiply(HX, HY, &HR) == 0, "Falha em hibrida_multiply");
+        ASSERT(matrix_multiply(X, Y, &Z) == 0 && hibrida_to_matrix(HR, &W) == 0, "Falha ao converter o produto");
+        ASSERT(same_matrix(Z, W), "hibrida_multiply difere de matrix_multiply");
+        ASSERT(hibrida_linhas_densas(HR) > 0, "Produto deveria ter linhas densas");
+        hibrida_destroy(HR);
+        matrix_destroy(Z);
+        matrix_destroy(W);
+
+        /* troca de forma com setelem/addelem, com histerese */
+        MatrixHibrida *H = hibrida_init(2, 8);
+        ASSERT(H, "Falha em hibrida_init");
+        for (int j = 1; j <= 3; j++) ASSERT(hibrida_setelem(H, 1, j, (float)j) == 0, "Falha em hibrida_setelem");
+        ASSERT(!H->rows[0].densa, "3 de 8 colunas deveria ser esparsa");
+        ASSERT(hibrida_addelem(H, 1, 8, 4.0f) == 0 && H->rows[0].densa, "4 de 8 colunas deveria ser densa");
+        ASSERT(hibrida_addelem(H, 1, 2, -2.0f) == 0 && H->rows[0].densa && H->rows[0].nnz == 3, "Histerese deveria manter densa");
+        ASSERT(hibrida_setelem(H, 1, 3, 0.0f) == 0 && hibrida_setelem(H, 1, 1, 0.0f) == 0, "Falha ao remover");
+        ASSERT(!H->rows[0].densa && H->rows[0].nnz == 1, "1 de 8 colunas deveria voltar a esparsa");
+        ASSERT(hibrida_getelem(H, 1, 8, &v) == 0 && v == 4.0f, "Erro H(1,8)");
+        ASSERT(hibrida_setelem(H, 3, 1, 1.0f) == 1, "setelem fora dos limites deveria falhar");
+        ASSERT(hibrida_to_matrix(H, &V) == 0 && V->mat[0]->coluna == 8 && !V->mat[0]->prox && !V->mat[1], "Erro em hibrida_to_matrix");
+
+        MatrixHibrida *HE = hibrida_init(3, 3);
+        ASSERT(hibrida_multiply(HX, HE, &HR) == 1 && !HR, "Dimensoes incompativeis deveriam falhar");
+        ASSERT(hibrida_add(HX, HE, &HR) == 1 && !HR, "Dimensoes incompativeis deveriam falhar");
+
+        hibrida_destroy(HE);
+        hibrida_destroy(H);
+        hibrida_destroy(HX);
+        hibrida_destroy(HY);
+        matrix_destroy(V);
+        matrix_destroy(X);
+        matrix_destroy(Y);
+    }
+
+    /* ---------- TESTE: operações elemento a elemento ---------- */
+    {
+        /* linha 1 de X curta e de Y cheia; linha 2 o contrário: exercita a busca galopante */
+        Matrix *X = init_matrix(30, 200), *Y = init_matrix(30, 200), *R = NULL, *E = NULL, *Z = NULL;
+        ASSERT(X && Y, "Falha ao criar X/Y");
+        fill_random(X, 41u, 20);
+        fill_random(Y, 42u, 20);
+        for (int j = 1; j <= 200; j++) {
+            matrix_setelem(X, 1, j, 0.0f);
+            matrix_setelem(Y, 1, j, (float)(j % 4 + 1));
+            matrix_setelem(X, 2, j, (float)(j % 3 + 1));
+            matrix_setelem(Y, 2, j, 0.0f);
+        }
+        matrix_setelem(X, 1, 7, 2.0f);
+        matrix_setelem(X, 1, 150, -3.0f);
+        matrix_setelem(X, 1, 200, 5.0f);
+        matrix_setelem(Y, 2, 1, 4.0f);
+        matrix_setelem(Y, 2, 199, -1.0f);
+
+        /* referência por getelem */
+        Matrix *H = init_matrix(30, 200), *M = init_matrix(30, 200), *MC = init_matrix(30, 200);
+        ASSERT(H && M && MC, "Falha ao criar referencias");
+        for (int i = 1; i <= 30; i++) {
+            for (int j = 1; j <= 200; j++) {
+                float vx = 0.0f, vy = 0.0f;
+                matrix_getelem(X, i, j, &vx);
+                matrix_getelem(Y, i, j, &vy);
+                matrix_setelem(H, i, j, vx * vy);
+                matrix_setelem(vy != 0.0f ? M : MC, i, j, vx);
+            }
+        }
+
+        for (int ix = 0; ix < 4; ix++) {
+            if (ix & 1) matrix_index_enable(X);
+            else matrix_index_disable(X);
+            if (ix & 2) matrix_index_enable(Y);
+            else matrix_index_disable(Y);
+
+            ASSERT(matrix_hadamard(X, Y, &R) == 0 && same_matrix(R, H), "matrix_hadamard difere da referencia");
+            matrix_destroy(R);
+            ASSERT(matrix_mask(X, Y, 0, &R) == 0 && same_matrix(R, M), "matrix_mask difere da referencia");
+            matrix_destroy(R);
+            ASSERT(matrix_mask(X, Y, 1, &R) == 0 && same_matrix(R, MC), "matrix_mask (complemento) difere");
+            matrix_destroy(R);
+        }
+
+        /* no lugar, com o índice de Z mantido */
+        E = init_matrix(30, 200);
+        ASSERT(matrix_add(X, E, &Z) == 0 && matrix_index_enable(Z) == 0, "Falha ao copiar X");
+        ASSERT(matrix_hadamard_inplace(Z, Y) == 0 && same_matrix(Z, H), "matrix_hadamard_inplace difere");
+        ASSERT(Z->indice && Z->indice[0].n == 3 && Z->indice[1].n == 2, "Indice de Z nao foi mantido");
+        ASSERT(matrix_setelem(Z, 1, 8, 1.0f) == 0 && assert_elem(Z, 1, 8, 1.0f) == 0, "Z inutilizavel apos hadamard");
+        matrix_destroy(Z);
+
+        ASSERT(matrix_add(X, E, &Z) == 0 && matrix_mask_inplace(Z, Y, 1) == 0 && same_matrix(Z, MC), "matrix_mask_inplace difere");
+        ASSERT(matrix_hadamard_inplace(Z, Z) == 1, "Operandos iguais deveriam falhar");
+        matrix_destroy(Z);
+
+        MatrixCSR *CX = NULL, *CY = NULL, *CR = NULL;
+        ASSERT(csr_from_matrix(X, &CX) == 0 && csr_from_matrix(Y, &CY) == 0, "Falha em csr_from_matrix");
+        ASSERT(csr_hadamard(CX, CY, &CR) == 0 && csr_to_matrix(CR, &Z) == 0, "Falha em csr_hadamard");
+        ASSERT(same_matrix(Z, H), "csr_hadamard difere da referencia");
+        matrix_destroy(Z);
+        csr_destroy(CR);
+        csr_destroy(CX);
+        csr_destroy(CY);
+
+        /* escala, corte e função por elemento */
+        ASSERT(matrix_add(X, E, &Z) == 0 && matrix_index_enable(Z) == 0, "Falha ao copiar X");
+        ASSERT(matrix_scale(Z, 2.0f) == 0 && assert_elem(Z, 1, 150, -6.0f) == 0, "Erro em matrix_scale");
+        ASSERT(matrix_drop(Z, 6.5f) == 0 && assert_elem(Z, 1, 150, 0.0f) == 0 && assert_elem(Z, 1, 200, 10.0f) == 0, "Erro em matrix_drop");
+        for (int i = 0; i < 30; i++) {
+            for (POINT p = Z->mat[i]; p; p = p->prox) ASSERT(p->valor >= 6.5f || p->valor <= -6.5f, "matrix_drop manteve elemento pequeno");
+        }
+        ASSERT(Z->indice[0].n == 1, "Indice de Z nao foi mantido no corte");
+
+        float limite = 0.0f;
+        ASSERT(matrix_apply(Z, relu, &limite) == 0, "Falha em matrix_apply");
+        for (int i = 0; i < 30; i++) {
+            for (POINT p = Z->mat[i]; p; p = p->prox) ASSERT(p->valor > 0.0f, "matrix_apply manteve negativo");
+        }
+        ASSERT(matrix_scale(Z, 0.0f) == 0, "Falha em matrix_scale(0)");
+        for (int i = 0; i < 30; i++) ASSERT(!Z->mat[i] && Z->indice[i].n == 0, "matrix_scale(0) deveria esvaziar");
+        ASSERT(matrix_apply(Z, NULL, NULL) == 1, "f NULL deveria falhar");
+        matrix_destroy(Z);
+
+        matrix_destroy(E);
+        matrix_destroy(H);
+        matrix_destroy(M);
+        matrix_destroy(MC);
+        matrix_destroy(X);
+        matrix_destroy(Y);
+    }
+
+    /* ---------- TESTE: semianéis ---------- */
+    {
+        Matrix *X = init_matrix(20, 25), *Y = init_matrix(25, 15), *M = init_matrix(20, 15);
+        MatrixCSR *CX = NULL, *CY = NULL, *CM = NULL, *CR = NULL, *CP = NULL;
+        ASSERT(X && Y && M, "Falha ao criar X/Y/M");
+        fill_random(X, 71u, 25);
+        fill_random(Y, 72u, 25);
+        fill_random(M, 73u, 40);
+        ASSERT(csr_from_matrix(X, &CX) == 0 && csr_from_matrix(Y, &CY) == 0 && csr_from_matrix(M, &CM) == 0,
+               "Falha em csr_from_matrix");
+
+        for (int mk = 0; mk < 3; mk++) {
+            const MatrixCSR *mc = mk ? CM : NULL;
+            const Matrix *mm = mk ? M : NULL;
+            int comp = mk == 2;
+
+            ASSERT(csr_mxm_plus_times(CX, CY, mc, comp, &CR) == 0 && confere_semianel(SR_PLUS_TIMES, X, Y, mm, comp, CR),
+                   "csr_mxm_plus_times difere da definicao");
+            csr_destroy(CR);
+            ASSERT(csr_mxm_min_plus(CX, CY, mc, comp, &CR) == 0 && confere_semianel(SR_MIN_PLUS, X, Y, mm, comp, CR),
+                   "csr_mxm_min_plus difere da definicao");
+            csr_destroy(CR);
+            ASSERT(csr_mxm_max_times(CX, CY, mc, comp, &CR) == 0 && confere_semianel(SR_MAX_TIMES, X, Y, mm, comp, CR),
+                   "csr_mxm_max_times difere da definicao");
+            csr_destroy(CR);
+            ASSERT(csr_mxm_lor_land(CX, CY, mc, comp, &CR) == 0 && confere_semianel(SR_LOR_LAND, X, Y, mm, comp, CR),
+                   "csr_mxm_lor_land difere da definicao");
+            csr_destroy(CR);
+            ASSERT(csr_mxm_max_min(CX, CY, mc, comp, &CR) == 0 && confere_semianel(SR_MAX_MIN, X, Y, mm, comp, CR),
+                   "Semianel do usuario difere da definicao");
+            csr_destroy(CR);
+        }
+
+        ASSERT(csr_mxm_plus_times(CX, CY, NULL, 0, &CR) == 0 && csr_multiply(CX, CY, &CP) == 0, "Falha no produto");
+        ASSERT(CR->nnz == CP->nnz && !memcmp(CR->col_idx, CP->col_idx, (size_t)CP->nnz * sizeof(int)) &&
+               !memcmp(CR->values, CP->values, (size_t)CP->nnz * sizeof(float)), "plus_times difere de csr_multiply");
+        csr_destroy(CR);
+        csr_destroy(CP);
+        ASSERT(csr_mxm_min_plus(CX, CX, NULL, 0, &CR) == 1, "Dimensoes incompativeis deveriam falhar");
+        ASSERT(csr_mxm_min_plus(CX, CY, CX, 0, &CR) == 1, "Mascara com dimensoes erradas deveria falhar");
+
+        /* SpMV: y = X ⊕.⊗ x, com e sem máscara */
+        float x[25], y[20], ym[20], mv[20];
+        for (int k = 0; k < 25; k++) x[k] = (float)(k % 7) - 2.0f;
+        for (int i = 0; i < 20; i++) mv[i] = (float)(i % 3 == 0);
+        ASSERT(csr_mxv_min_plus(CX, x, NULL, 0, y) == 0 && csr_mxv_min_plus(CX, x, mv, 1, ym) == 0, "Falha em csr_mxv_min_plus");
+        for (int i = 0; i < 20; i++) {
+            float esperado = __builtin_inff();
+            for (int k = CX->row_ptr[i]; k < CX->row_ptr[i + 1]; k++) {
+                float p = CX->values[k] + x[CX->col_idx[k]];
+                if (p < esperado) esperado = p;
+            }
+            ASSERT(y[i] == esperado, "csr_mxv_min_plus difere da definicao");
+            ASSERT(ym[i] == (mv[i] != 0.0f ? __builtin_inff() : esperado), "Mascara de csr_mxv_min_plus errada");
+        }
+
+        /* busca em largura como produtos or-and: próxima fronteira = Aᵀ f, sem os visitados */
+        enum { NV = 40 };
+        Matrix *G = init_matrix(NV, NV);
+        MatrixCSR *CG = NULL, *CGT = NULL;
+        ASSERT(G, "Falha ao criar G");
+        fill_random(G, 74u, 4);
+        ASSERT(csr_from_matrix(G, &CG) == 0 && csr_transpose(CG, &CGT) == 0, "Falha ao montar o grafo");
+
+        int nivel[NV], nivel_ref[NV];
+        float fronteira[NV], proxima[NV], visitado[NV];
+        for (int v = 0; v < NV; v++) {
+            nivel[v] = nivel_ref[v] = -1;
+            fronteira[v] = visitado[v] = 0.0f;
+        }
+        fronteira[0] = visitado[0] = 1.0f;
+        nivel[0] = 0;
+        for (int d = 1, ativo = 1; ativo; d++) {
+            ASSERT(csr_mxv_lor_land(CGT, fronteira, visitado, 1, proxima) == 0, "Falha em csr_mxv_lor_land");
+            ativo = 0;
+            for (int v = 0; v < NV; v++) {
+                fronteira[v] = proxima[v];
+                if (proxima[v] != 0.0f) {
+                    visitado[v] = 1.0f;
+                    nivel[v] = d;
+                    ativo = 1;
+                }
+            }
+        }
+
+        /* referência: fila sobre as listas */
+        int fila[NV], ini = 0, fim = 0;
+        nivel_ref[0] = 0;
+        fila[fim++] = 0;
+        while (ini < fim) {
+            int u = fila[ini++];
+            for (POINT p = G->mat[u]; p; p = p->prox) {
+                if (nivel_ref[p->coluna - 1] < 0) {
+                    nivel_ref[p->coluna - 1] = nivel_ref[u] + 1;
+                    fila[fim++] = p->coluna - 1;
+                }
+            }
+        }
+        ASSERT(!memcmp(nivel, nivel_ref, sizeof(nivel)), "Busca em largura por semianel difere da referencia");
+        ASSERT(fim > 1, "Grafo de teste sem arestas a partir de 0");
+
+        csr_destroy(CG);
+        csr_destroy(CGT);
+        matrix_destroy(G);
+        csr_destroy(CX);
+        csr_destroy(CY);
+        csr_destroy(CM);
+        matrix_destroy(X);
+        matrix_destroy(Y);
+        matrix_destroy(M);
+    }
+
+    /* ---------- TESTE: geradores ---------- */
+    {
+        Matrix *G = NULL, *H = NULL;
+        ASSERT(generate_banded(30, 2, 1u, &G) == 0, "Falha em generate_banded");
+        float v = 0.0f;
+        ASSERT(assert_elem(G, 1, 4, 0.0f) == 0, "Elemento fora da banda");
+        ASSERT(matrix_getelem(G, 3, 5, &v) == 0 && v != 0.0f, "Erro na banda");
+        matrix_destroy(G);
+
+        ASSERT(generate_uniform(50, 60, 0.1, 5u, &G) == 0, "Falha em generate_uniform");
+        ASSERT(generate_uniform(50, 60, 0.1, 5u, &H) == 0, "Falha em generate_uniform (repeticao)");
+        ASSERT(same_matrix(G, H), "Mesma semente deveria gerar a mesma matriz");
+        matrix_destroy(G);
+        matrix_destroy(H);
+
+        ASSERT(generate_block_diagonal(4, 5, 1.0, 2u, &G) == 0, "Falha em generate_block_diagonal");
+        ASSERT(G->linhas == 20 && matrix_getelem(G, 6, 10, &v) == 0 && v != 0.0f, "Erro no bloco");
+        ASSERT(assert_elem(G, 5, 6, 0.0f) == 0, "Elemento fora dos blocos");
+        matrix_destroy(G);
+
+        ASSERT(generate_powerlaw(100, 100, 40, 3u, &G) == 0, "Falha em generate_powerlaw");
+        matrix_destroy(G);
+        ASSERT(generate_uniform(10, 10, 1.5, 1u, &G) == 1 && !G, "Densidade invalida deveria falhar");
+    }
+
+    /* ---------- TESTE: tipos de valor ---------- */
+    {
+        /* 1e8 + 1 - 1e8: em float a parcela 1 se perde */
+        int is[] = {1, 1, 1, 2, 2};
+        int js[] = {1, 1, 1, 1, 2};
+        double vd[] = {1e8, 1.0, -1e8, 0.5, 2.0};
+        int32_t vi[] = {3, 4, -2, 7, -1};
+
+        MatrixCSR_d *D = NULL, *DT = NULL, *DD = NULL;
+        double d = 0.0;
+        ASSERT(csr_from_coo_d(2, 2, is, js, vd, 5, &D) == 0, "Falha em csr_from_coo_d");
+        ASSERT(csr_getelem_d(D, 1, 1, &d) == 0 && d == 1.0, "Erro na soma em double");
+        ASSERT(csr_transpose_d(D, &DT) == 0, "Falha em csr_transpose_d");
+        ASSERT(csr_getelem_d(DT, 1, 2, &d) == 0 && d == 0.5, "Erro na transposta double");
+        ASSERT(csr_multiply_d(D, DT, &DD) == 0, "Falha em csr_multiply_d");
+        ASSERT(csr_getelem_d(DD, 2, 2, &d) == 0 && d == 4.25, "Erro no produto double");
+        double xd[] = {1.0, 2.0}, yd[2];
+        ASSERT(csr_spmv_d(D, xd, yd) == 0 && yd[0] == 1.0 && yd[1] == 4.5, "Erro em csr_spmv_d");
+        csr_destroy_d(DD);
+        csr_destroy_d(DT);
+        csr_destroy_d(D);
+
+        MatrixCSR_i *I = NULL, *II = NULL;
+        int32_t v = 0;
+        ASSERT(csr_from_coo_i(2, 2, is, js, vi, 5, &I) == 0, "Falha em csr_from_coo_i");
+        ASSERT(csr_getelem_i(I, 1, 1, &v) == 0 && v == 5, "Erro na soma int32");
+        ASSERT(csr_add_i(I, I, &II) == 0, "Falha em csr_add_i");
+        ASSERT(csr_getelem_i(II, 2, 2, &v) == 0 && v == -2, "Erro em csr_add_i");
+        csr_destroy_i(II);
+        ASSERT(csr_multiply_i(I, I, &II) == 0, "Falha em csr_multiply_i");
+        ASSERT(csr_getelem_i(II, 2, 1, &v) == 0 && v == 28, "Erro em csr_multiply_i");
+        int32_t xi[] = {1, 1}, yi[2];
+        ASSERT(csr_spmv_i(I, xi, yi) == 0 && yi[0] == 5 && yi[1] == 6, "Erro em csr_spmv_i");
+        csr_destroy_i(II);
+        csr_destroy_i(I);
+
+        MatrixCSR_p *P = NULL, *PT = NULL, *PP = NULL;
+        int presente = 0;
+        ASSERT(csr_from_coo_p(2, 2, is, js, 5, &P) == 0, "Falha em csr_from_coo_p");
+        ASSERT(P->nnz == 3, "Repeticoes deveriam ser unificadas no padrao");
+        ASSERT(csr_getelem_p(P, 1, 2, &presente) == 0 && presente == 0, "Erro em csr_getelem_p");
+        ASSERT(csr_transpose_p(P, &PT) == 0, "Falha em csr_transpose_p");
+        ASSERT(csr_add_p(P, PT, &PP) == 0 && PP->nnz == 4, "Erro em csr_add_p");
+        csr_destroy_p(PP);
+        ASSERT(csr_multiply_p(PT, P, &PP) == 0, "Falha em csr_multiply_p");
+        ASSERT(csr_getelem_p(PP, 1, 2, &presente) == 0 && presente == 1, "Erro em csr_multiply_p");
+        float xp[] = {1.0f, 2.0f}, yp[2];
+        ASSERT(csr_spmv_p(P, xp, yp) == 0 && yp[0] == 1.0f && yp[1] == 3.0f, "Erro em csr_spmv_p");
+        csr_destroy_p(PP);
+        csr_destroy_p(PT);
+        csr_destroy_p(P);
+
+        Matrix *L = init_matrix(1, 3), *U = init_matrix(3, 1), *LU = NULL;
+        ASSERT(L && U, "Falha ao criar L/U");
+        matrix_setelem(L, 1, 1, 1e8f);
+        matrix_setelem(L, 1, 2, 1.0f);
+        matrix_setelem(L, 1, 3, -1e8f);
+        for (int k = 1; k <= 3; k++) matrix_setelem(U, k, 1, 1.0f);
+        ASSERT(matrix_multiply(L, U, &LU) == 0, "Falha em L*U");
+        ASSERT(assert_elem(LU, 1, 1, 1.0f) == 0, "Produto deveria acumular em double");
+
+        MatrixCSR_i *LI = NULL;
+        matrix_setelem(L, 1, 2, 0.5f);
+        ASSERT(csr_from_matrix_i(L, &LI) == 0 && LI->nnz == 2, "0.5 truncado deveria ser descartado");
+        csr_destroy_i(LI);
+
+        matrix_destroy(LU);
+        matrix_destroy(U);
+        matrix_destroy(L);
+    }
+
+    /* ---------- TESTE: CSR ---------- */
+    MatrixCSR *CA = NULL, *CB = NULL, *CC = NULL;
+    ASSERT(csr_from_matrix(A, &CA) == 0, "Falha em csr_from_matrix(A)");
+    ASSERT(csr_from_matrix(B, &CB) == 0, "Falha em csr_from_matrix(B)");
+    ASSERT(CA->nnz == 3 && CB->nnz == 2, "Erro nnz CSR");
+    ASSERT(assert_csr_elem(CA, 1, 2, 2.0f) == 0, "Erro CSR A(1,2)");
+    ASSERT(assert_csr_elem(CA, 2, 2, 0.0f) == 0, "Erro CSR A(2,2)");
+
+    ASSERT(csr_add(CA, CB, &CC) == 0, "Falha em csr_add");
+    ASSERT(assert_csr_elem(CC, 1, 1, 5.0f) == 0, "Erro CSR A+B (1,1)");
+    ASSERT(assert_csr_elem(CC, 2, 2, 5.0f) == 0, "Erro CSR A+B (2,2)");
+    csr_destroy(CC);
+
+    ASSERT(csr_transpose(CA, &CC) == 0, "Falha em csr_transpose");
+    ASSERT(assert_csr_elem(CC, 2, 1, 2.0f) == 0, "Erro CSR AT(2,1)");
+    ASSERT(assert_csr_elem(CC, 1, 2, 3.0f) == 0, "Erro CSR AT(1,2)");
+    csr_destroy(CC);
+
+    ASSERT(csr_multiply(CA, CB, &CC) == 0, "Falha em csr_multiply");
+    ASSERT(assert_csr_elem(CC, 1, 2, 10.0f) == 0, "Erro CSR A*B (1,2)");
+    ASSERT(assert_csr_elem(CC, 2, 1, 12.0f) == 0, "Erro CSR A*B (2,1)");
+    ASSERT(CC->nnz == 3, "Erro nnz CSR A*B");
+
+    ASSERT(csr_to_matrix(CC, &C) == 0, "Falha em csr_to_matrix");
+    ASSERT(assert_elem(C, 1, 1, 4.0f) == 0, "Erro CSR->Matrix (1,1)");
+
+    csr_destroy(CA);
+    csr_destroy(CB);
+    csr_destroy(CC);
+
     matrix_destroy(C);
     matrix_destroy(A);
     matrix_destroy(B);